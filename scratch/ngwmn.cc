@@ -7,11 +7,14 @@
 #include "ns3/mesh-module.h"
 #include "ns3/mobility-module.h"
 #include "ns3/mesh-helper.h"
+#include "ns3/replication-runner.h"
+#include "ns3/replication-helper.h"
 #include <iostream>
 #include <fstream>
 
 /* variable parameters */
 #define REPEATS 			10					/* how many repeats for statistical purposes 	*/
+#define JOBS				0					/* how many repeats run in parallel, 0 for one per core */
 #define MAXPACKETS 			100000				/* max packets before simulation terminates		*/
 #define TOTALTIME			100					/* max time (s) before simulation terminates	*/
 #define PACKETINTERVAL		0.01					/* inter-arrival rate */
@@ -23,6 +26,11 @@
 
 /* Logging options */
 #define PCAPENABLED 		false
+#define PROFILING			false				/* print the time spent per event type at the end of each repeat */
+
+/* Delay policy of the wifi queues: ns3::WifiMacQueueDelayPolicy (no delay, the baseline),
+   or, opt-in, ns3::MixedBiasDelayPolicy or ns3::AdaptiveMixedBiasDelayPolicy */
+#define DELAYPOLICY			"ns3::WifiMacQueueDelayPolicy"
 
 /* Fixed parameters */
 #define RANDOMSTART			0.5					/* maximum random start delay for MAC address so that all nodes don't start at once */
@@ -63,7 +71,7 @@ void NGWMN::Initialize(int experiment_id)
 	std::string m_root = "ff:ff:ff:ff:ff:ff";
 	std::string m_stack = "ns3::Dot11sStack";
 	
-	SeedManager::SetRun(experiment_id);
+	/* SeedManager::SetRun(experiment_id) is called by the replication runner */
 	
 	nodes.Create(XNODES * YNODES);			/* Construct the topology of the network */
 	
@@ -120,6 +128,9 @@ void NGWMN::InstallApplications()
 	serverapp.Stop (Seconds (TOTALTIME));
 	s = server.GetServer();
 	
+	/* The adaptive delay policies measure their solutions with the statistics of the gateway */
+	MeshHelper::ConnectRxStats (s, meshRouterDevices);
+	
 	/* Source MRs */
 	UdpClientHelper client (interfaces.GetAddress (0), PORT);
 	client.SetAttribute ("MaxPackets", UintegerValue (MAXPACKETS));
@@ -159,26 +170,40 @@ void NGWMN::Report()
 	double delayPerPacket = (double)totalDelay.GetSeconds() / (double)s->GetReceived ();
 	double pdr = (double)s->GetReceived () / ((double)s->GetReceived () + (double)s->GetLost ());
 	std::cout << "PDR: " << pdr << " DELAY: " << delayPerPacket << "s" << std::endl;	
-	pdrfile << pdr << std::endl;
-	delayfile << delayPerPacket << std::endl;
+	ReplicationHelper::RecordUdpServer (s);
+}
+
+/* Runs one repeat in its own process */
+static void RunExperiment(uint32_t run)
+{
+	Config::SetDefault ("ns3::DefaultSimulatorImpl::Profiling", BooleanValue (PROFILING));
+	ObjectFactory delayPolicy;
+	delayPolicy.SetTypeId (DELAYPOLICY);
+	Config::SetDefault ("ns3::WifiMacQueue::DelayPolicy", ObjectFactoryValue (delayPolicy));
+	NGWMN experiment;
+	experiment.Initialize(run);
+	experiment.InstallApplications();
+	experiment.Run();
+	experiment.Report();
 }
 
 int main(int argc, char* argv[])
 {
-	int r;
+	ReplicationRunner runner;
+	runner.SetReplications (REPEATS);
+	runner.SetJobs (JOBS);
+	runner.Run (MakeCallback (&RunExperiment));
+	runner.Print (std::cout);
 	
 	/* Logging files */
 	pdrfile.open ("/home/jernst/pdr.txt");
 	delayfile.open("/home/jernst/delay.txt");
-	
-	for(r = 0; r < REPEATS; r++)
+	std::vector<double> pdr = runner.GetValues ("pdr");
+	std::vector<double> delay = runner.GetValues ("delay");
+	for (uint32_t r = 0; r < pdr.size (); r++)
 	{
-		NGWMN experiment;
-		experiment.Initialize(r);
-		experiment.InstallApplications();
-		experiment.Run();
-		experiment.Report();
-		std::cout << r+1 << "/" << REPEATS << " - " << ((double)(r+1) / (double)REPEATS)*100 << "%" << std::endl;
+		pdrfile << pdr[r] << std::endl;
+		delayfile << delay[r] << std::endl;
 	}
 	std::cout << '\a';
 	pdrfile.close();
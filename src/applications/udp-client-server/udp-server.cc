@@ -28,6 +28,7 @@
 #include "ns3/socket-factory.h"
 #include "ns3/packet.h"
 #include "ns3/uinteger.h"
+#include "ns3/trace-source-accessor.h"
 #include "packet-loss-counter.h"
 
 #include "seq-ts-header.h"
@@ -56,6 +57,9 @@ UdpServer::GetTypeId (void)
                    MakeUintegerAccessor (&UdpServer::GetPacketWindowSize,
                                          &UdpServer::SetPacketWindowSize),
                    MakeUintegerChecker<uint16_t> (8,256))
+    .AddTraceSource ("RxStats",
+                     "The number of received and lost packets and the total delay of the received packets, after each reception.",
+                     MakeTraceSourceAccessor (&UdpServer::m_rxStatsTrace))
     ;
   return tid;
 }
@@ -164,6 +168,7 @@ UdpServer::HandleRead (Ptr<Socket> socket)
           m_lossCounter.NotifyReceived (currentSequenceNumber);
           m_received++;
           m_totalDelay += delay;
+          m_rxStatsTrace (m_received, GetLost (), m_totalDelay);
         }
     }
 }
@@ -27,6 +27,7 @@
 #include "ns3/event-id.h"
 #include "ns3/ptr.h"
 #include "ns3/address.h"
+#include "ns3/traced-callback.h"
 #include "packet-loss-counter.h"
 namespace ns3 {
 /**
@@ -94,6 +95,7 @@ private:
   uint32_t m_received;
   Time m_totalDelay;
   PacketLossCounter m_lossCounter;
+  TracedCallback<uint32_t, uint32_t, Time> m_rxStatsTrace;
 };
 
 } // namespace ns3
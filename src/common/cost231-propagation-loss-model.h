@@ -76,6 +76,7 @@ public:
   void SetShadowing (double shadowing);
 private:
   virtual double DoCalcRxPower (double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+  virtual bool DoIsDeterministic (void) const;
   double m_BSAntennaHeight; // in meter
   double m_SSAntennaHeight; // in meter
   double C;
@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef PROPAGATION_CACHE_H
+#define PROPAGATION_CACHE_H
+
+#include "ns3/ptr.h"
+#include "ns3/callback.h"
+#include "ns3/mobility-model.h"
+#include <map>
+
+namespace ns3 {
+
+/**
+ * \brief store a value per (source, destination) pair of mobility models
+ *
+ * The values stored for a pair are dropped as soon as either mobility
+ * model reports a course change. The pairs in which either mobility
+ * model has a non-zero velocity are never stored since their
+ * positions change without any notification.
+ *
+ * This is used by the propagation models which cache the results of
+ * other models: ns3::CachingPropagationLossModel and
+ * ns3::CachingPropagationDelayModel.
+ */
+template <typename T>
+class PropagationCache
+{
+public:
+  PropagationCache ();
+  ~PropagationCache ();
+
+  /**
+   * \param a the mobility model of the source
+   * \param b the mobility model of the destination
+   * \param value the value stored for this pair, if any.
+   * \returns true if a value is stored for this pair, false otherwise.
+   */
+  bool Lookup (Ptr<MobilityModel> a, Ptr<MobilityModel> b, T *value) const;
+  /**
+   * \param a the mobility model of the source
+   * \param b the mobility model of the destination
+   * \param value the value to store for this pair.
+   *
+   * Nothing is stored if either a or b is moving.
+   */
+  void Add (Ptr<MobilityModel> a, Ptr<MobilityModel> b, const T &value);
+  /**
+   * Drop all the values and stop listening to the course changes.
+   */
+  void Clear (void);
+
+private:
+  typedef std::pair<const MobilityModel *, const MobilityModel *> Key;
+  typedef std::map<Key, T> Values;
+  typedef std::map<const MobilityModel *, Ptr<MobilityModel> > Tracked;
+
+  static bool IsStatic (Ptr<MobilityModel> mobility);
+  void Track (Ptr<MobilityModel> mobility);
+  void CourseChanged (Ptr<const MobilityModel> mobility);
+
+  Values m_values;
+  // the mobility models whose course changes we listen to. They are
+  // held to make sure that their address is not reused while it
+  // appears in m_values.
+  Tracked m_tracked;
+};
+
+} // namespace ns3
+
+namespace ns3 {
+
+template <typename T>
+PropagationCache<T>::PropagationCache ()
+{}
+
+template <typename T>
+PropagationCache<T>::~PropagationCache ()
+{
+  Clear ();
+}
+
+template <typename T>
+bool
+PropagationCache<T>::IsStatic (Ptr<MobilityModel> mobility)
+{
+  Vector velocity = mobility->GetVelocity ();
+  return velocity.x == 0 && velocity.y == 0 && velocity.z == 0;
+}
+
+template <typename T>
+bool
+PropagationCache<T>::Lookup (Ptr<MobilityModel> a, Ptr<MobilityModel> b, T *value) const
+{
+  typename Values::const_iterator i = m_values.find (Key (PeekPointer (a), PeekPointer (b)));
+  if (i == m_values.end ())
+    {
+      return false;
+    }
+  *value = i->second;
+  return true;
+}
+
+template <typename T>
+void
+PropagationCache<T>::Add (Ptr<MobilityModel> a, Ptr<MobilityModel> b, const T &value)
+{
+  if (!IsStatic (a) || !IsStatic (b))
+    {
+      return;
+    }
+  Track (a);
+  Track (b);
+  m_values[Key (PeekPointer (a), PeekPointer (b))] = value;
+}
+
+template <typename T>
+void
+PropagationCache<T>::Track (Ptr<MobilityModel> mobility)
+{
+  if (m_tracked.find (PeekPointer (mobility)) != m_tracked.end ())
+    {
+      return;
+    }
+  m_tracked[PeekPointer (mobility)] = mobility;
+  mobility->TraceConnectWithoutContext ("CourseChange",
+                                        MakeCallback (&PropagationCache<T>::CourseChanged, this));
+}
+
+template <typename T>
+void
+PropagationCache<T>::CourseChanged (Ptr<const MobilityModel> mobility)
+{
+  const MobilityModel *changed = PeekPointer (mobility);
+  typename Values::iterator i = m_values.begin ();
+  while (i != m_values.end ())
+    {
+      if (i->first.first == changed || i->first.second == changed)
+        {
+          m_values.erase (i++);
+        }
+      else
+        {
+          i++;
+        }
+    }
+}
+
+template <typename T>
+void
+PropagationCache<T>::Clear (void)
+{
+  for (typename Tracked::iterator i = m_tracked.begin (); i != m_tracked.end (); i++)
+    {
+      i->second->TraceDisconnectWithoutContext ("CourseChange",
+                                                MakeCallback (&PropagationCache<T>::CourseChanged, this));
+    }
+  m_tracked.clear ();
+  m_values.clear ();
+}
+
+} // namespace ns3
+
+#endif /* PROPAGATION_CACHE_H */
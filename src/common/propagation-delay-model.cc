@@ -21,6 +21,10 @@
 #include "ns3/random-variable.h"
 #include "ns3/mobility-model.h"
 #include "ns3/double.h"
+#include "ns3/pointer.h"
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE ("PropagationDelayModel");
 
 namespace ns3 {
 
@@ -38,6 +42,18 @@ PropagationDelayModel::GetTypeId (void)
 PropagationDelayModel::~PropagationDelayModel ()
 {}
 
+bool
+PropagationDelayModel::IsDeterministic (void) const
+{
+  return DoIsDeterministic ();
+}
+
+bool
+PropagationDelayModel::DoIsDeterministic (void) const
+{
+  return false;
+}
+
 NS_OBJECT_ENSURE_REGISTERED (RandomPropagationDelayModel);
 
 TypeId 
@@ -90,6 +106,11 @@ ConstantSpeedPropagationDelayModel::GetDelay (Ptr<MobilityModel> a, Ptr<Mobility
   double seconds = distance / m_speed;
   return Seconds (seconds);
 }
+bool
+ConstantSpeedPropagationDelayModel::DoIsDeterministic (void) const
+{
+  return true;
+}
 void 
 ConstantSpeedPropagationDelayModel::SetSpeed (double speed)
 {
@@ -101,4 +122,72 @@ ConstantSpeedPropagationDelayModel::GetSpeed (void) const
   return m_speed;
 }
 
+NS_OBJECT_ENSURE_REGISTERED (CachingPropagationDelayModel);
+
+TypeId
+CachingPropagationDelayModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CachingPropagationDelayModel")
+    .SetParent<PropagationDelayModel> ()
+    .AddConstructor<CachingPropagationDelayModel> ()
+    .AddAttribute ("DelayModel", "The model whose delays are cached.",
+                   PointerValue (),
+                   MakePointerAccessor (&CachingPropagationDelayModel::SetDelayModel,
+                                        &CachingPropagationDelayModel::GetDelayModel),
+                   MakePointerChecker<PropagationDelayModel> ())
+    ;
+  return tid;
+}
+
+CachingPropagationDelayModel::CachingPropagationDelayModel ()
+  : m_deterministic (false)
+{}
+CachingPropagationDelayModel::~CachingPropagationDelayModel ()
+{}
+void
+CachingPropagationDelayModel::DoDispose (void)
+{
+  m_cache.Clear ();
+  m_delay = 0;
+  PropagationDelayModel::DoDispose ();
+}
+void
+CachingPropagationDelayModel::SetDelayModel (Ptr<PropagationDelayModel> delay)
+{
+  m_cache.Clear ();
+  m_delay = delay;
+  m_deterministic = delay != 0 && delay->IsDeterministic ();
+  if (delay != 0 && !m_deterministic)
+    {
+      NS_LOG_WARN ("The delays of a non-deterministic model are not cached");
+    }
+}
+Ptr<PropagationDelayModel>
+CachingPropagationDelayModel::GetDelayModel (void) const
+{
+  return m_delay;
+}
+Time
+CachingPropagationDelayModel::GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+{
+  NS_ASSERT (m_delay != 0);
+  if (!m_deterministic)
+    {
+      return m_delay->GetDelay (a, b);
+    }
+  Time delay;
+  if (m_cache.Lookup (a, b, &delay))
+    {
+      return delay;
+    }
+  delay = m_delay->GetDelay (a, b);
+  m_cache.Add (a, b, delay);
+  return delay;
+}
+bool
+CachingPropagationDelayModel::DoIsDeterministic (void) const
+{
+  return m_deterministic;
+}
+
 } // namespace ns3
@@ -24,6 +24,7 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/random-variable.h"
+#include "propagation-cache.h"
 
 namespace ns3 {
 
@@ -46,6 +47,20 @@ public:
    * source and destination.
    */
   virtual Time GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const = 0;
+  /**
+   * \returns true if this model always returns the same delay for
+   *          the same positions.
+   *
+   * Only the delays computed by deterministic models can be cached:
+   * see ns3::CachingPropagationDelayModel.
+   */
+  bool IsDeterministic (void) const;
+private:
+  /**
+   * The default implementation returns false: the subclasses which
+   * do not depend on random variables or on the time override it.
+   */
+  virtual bool DoIsDeterministic (void) const;
 };
 
 /**
@@ -88,9 +103,45 @@ public:
    */
   double GetSpeed (void) const;
 private:
+  virtual bool DoIsDeterministic (void) const;
+
   double m_speed;
 };
 
+/**
+ * \brief Cache the delays computed by another model.
+ *
+ * For each (source, destination) pair of mobility models, the delay
+ * computed by the wrapped model is stored and returned until either
+ * mobility model reports a course change. The pairs in which either
+ * node moves at a non-zero velocity are never cached. Non-deterministic
+ * models, such as ns3::RandomPropagationDelayModel, are not cached.
+ *
+ * The parameters of the wrapped model must not change once it is
+ * used through this cache.
+ */
+class CachingPropagationDelayModel : public PropagationDelayModel
+{
+public:
+  static TypeId GetTypeId (void);
+
+  CachingPropagationDelayModel ();
+  virtual ~CachingPropagationDelayModel ();
+  virtual Time GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+  /**
+   * \param delay the model whose results are cached.
+   */
+  void SetDelayModel (Ptr<PropagationDelayModel> delay);
+  Ptr<PropagationDelayModel> GetDelayModel (void) const;
+private:
+  virtual void DoDispose (void);
+  virtual bool DoIsDeterministic (void) const;
+
+  Ptr<PropagationDelayModel> m_delay;
+  bool m_deterministic;
+  mutable PropagationCache<Time> m_cache;
+};
+
 } // namespace ns3
 
 #endif /* PROPAGATION_DELAY_MODEL_H */
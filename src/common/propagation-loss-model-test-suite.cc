@@ -462,6 +462,75 @@ RangePropagationLossModelTestCase::DoRun (void)
   return GetErrorStatus ();
 }
 
+class CachingPropagationModelTestCase : public TestCase
+{
+public:
+  CachingPropagationModelTestCase ();
+  virtual ~CachingPropagationModelTestCase ();
+
+private:
+  virtual bool DoRun (void);
+};
+
+CachingPropagationModelTestCase::CachingPropagationModelTestCase ()
+  : TestCase ("Test CachingPropagationLossModel and CachingPropagationDelayModel")
+{
+}
+
+CachingPropagationModelTestCase::~CachingPropagationModelTestCase ()
+{
+}
+
+bool
+CachingPropagationModelTestCase::DoRun (void)
+{
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  a->SetPosition (Vector (0,0,0));
+  Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+  b->SetPosition (Vector (100,0,0));
+  double tolerance = 1e-6;
+
+  Ptr<LogDistancePropagationLossModel> logDistance = CreateObject<LogDistancePropagationLossModel> ();
+  Ptr<CachingPropagationLossModel> loss = CreateObject<CachingPropagationLossModel> ();
+  loss->SetLossModel (logDistance);
+  NS_TEST_EXPECT_MSG_EQ (loss->IsDeterministic (), true, "LogDistancePropagationLossModel should be cached");
+  double expected = logDistance->CalcRxPower (16, a, b);
+  NS_TEST_EXPECT_MSG_EQ_TOL (loss->CalcRxPower (16, a, b), expected, tolerance, "Got unexpected rcv power");
+  NS_TEST_EXPECT_MSG_EQ_TOL (loss->CalcRxPower (16, a, b), expected, tolerance, "Got unexpected cached rcv power");
+  // a different tx power is not served from the cache.
+  NS_TEST_EXPECT_MSG_EQ_TOL (loss->CalcRxPower (10, a, b), expected - 6, tolerance, "Got unexpected rcv power");
+  // a course change invalidates the cached value.
+  b->SetPosition (Vector (200,0,0));
+  expected = logDistance->CalcRxPower (16, a, b);
+  NS_TEST_EXPECT_MSG_EQ_TOL (loss->CalcRxPower (16, a, b), expected, tolerance, "Stale cached rcv power");
+  a->SetPosition (Vector (100,0,0));
+  expected = logDistance->CalcRxPower (16, a, b);
+  NS_TEST_EXPECT_MSG_EQ_TOL (loss->CalcRxPower (16, a, b), expected, tolerance, "Stale cached rcv power");
+
+  // stochastic models, even chained after a deterministic one, are not cached.
+  logDistance->SetNext (CreateObject<NakagamiPropagationLossModel> ());
+  loss->SetLossModel (logDistance);
+  NS_TEST_EXPECT_MSG_EQ (loss->IsDeterministic (), false, "NakagamiPropagationLossModel should not be cached");
+  loss->SetLossModel (CreateObject<RandomPropagationLossModel> ());
+  NS_TEST_EXPECT_MSG_EQ (loss->IsDeterministic (), false, "RandomPropagationLossModel should not be cached");
+
+  Ptr<ConstantSpeedPropagationDelayModel> constantSpeed = CreateObject<ConstantSpeedPropagationDelayModel> ();
+  Ptr<CachingPropagationDelayModel> delay = CreateObject<CachingPropagationDelayModel> ();
+  delay->SetDelayModel (constantSpeed);
+  NS_TEST_EXPECT_MSG_EQ (delay->IsDeterministic (), true, "ConstantSpeedPropagationDelayModel should be cached");
+  Time expectedDelay = constantSpeed->GetDelay (a, b);
+  NS_TEST_EXPECT_MSG_EQ (delay->GetDelay (a, b), expectedDelay, "Got unexpected delay");
+  NS_TEST_EXPECT_MSG_EQ (delay->GetDelay (a, b), expectedDelay, "Got unexpected cached delay");
+  b->SetPosition (Vector (400,0,0));
+  expectedDelay = constantSpeed->GetDelay (a, b);
+  NS_TEST_EXPECT_MSG_EQ (delay->GetDelay (a, b), expectedDelay, "Stale cached delay");
+  delay->SetDelayModel (CreateObject<RandomPropagationDelayModel> ());
+  NS_TEST_EXPECT_MSG_EQ (delay->IsDeterministic (), false, "RandomPropagationDelayModel should not be cached");
+  Simulator::Destroy ();
+
+  return GetErrorStatus ();
+}
+
 class PropagationLossModelsTestSuite : public TestSuite
 {
 public:
@@ -476,6 +545,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite ()
   AddTestCase (new LogDistancePropagationLossModelTestCase);
   AddTestCase (new MatrixPropagationLossModelTestCase);
   AddTestCase (new RangePropagationLossModelTestCase);
+  AddTestCase (new CachingPropagationModelTestCase);
 }
 
 PropagationLossModelsTestSuite WifiPropagationLossModelsTestSuite;
@@ -26,6 +26,7 @@
 #include "ns3/mobility-model.h"
 #include "ns3/boolean.h"
 #include "ns3/double.h"
+#include "ns3/pointer.h"
 #include <math.h>
 
 NS_LOG_COMPONENT_DEFINE ("PropagationLossModel");
@@ -71,6 +72,22 @@ PropagationLossModel::CalcRxPower (double txPowerDbm,
   return self;
 }
 
+bool
+PropagationLossModel::IsDeterministic (void) const
+{
+  if (!DoIsDeterministic ())
+    {
+      return false;
+    }
+  return m_next == 0 || m_next->IsDeterministic ();
+}
+
+bool
+PropagationLossModel::DoIsDeterministic (void) const
+{
+  return false;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (RandomPropagationLossModel);
@@ -234,6 +251,12 @@ FriisPropagationLossModel::DoCalcRxPower (double txPowerDbm,
   return txPowerDbm + pr;
 }
 
+bool
+FriisPropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 // -- Two-Ray Ground Model ported from NS-2 -- tomhewer@mac.com -- Nov09 //
 
@@ -403,6 +426,12 @@ TwoRayGroundPropagationLossModel::DoCalcRxPower (double txPowerDbm,
     }
 }
 
+bool
+TwoRayGroundPropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 
 // ------------------------------------------------------------------------- //
 
@@ -485,6 +514,12 @@ LogDistancePropagationLossModel::DoCalcRxPower (double txPowerDbm,
   return txPowerDbm + rxc;
 }
 
+bool
+LogDistancePropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (ThreeLogDistancePropagationLossModel);
@@ -580,6 +615,12 @@ ThreeLogDistancePropagationLossModel::DoCalcRxPower (double txPowerDbm,
   return txPowerDbm - pathLossDb;
 }
 
+bool
+ThreeLogDistancePropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (NakagamiPropagationLossModel);
@@ -713,6 +754,12 @@ FixedRssLossModel::DoCalcRxPower (double txPowerDbm,
   return m_rss;
 }
 
+bool
+FixedRssLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (MatrixPropagationLossModel);
@@ -827,6 +874,88 @@ RangePropagationLossModel::DoCalcRxPower (double txPowerDbm,
     }
 }
 
+bool
+RangePropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 
+NS_OBJECT_ENSURE_REGISTERED (CachingPropagationLossModel);
+
+TypeId
+CachingPropagationLossModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CachingPropagationLossModel")
+    .SetParent<PropagationLossModel> ()
+    .AddConstructor<CachingPropagationLossModel> ()
+    .AddAttribute ("LossModel", "The model whose reception powers are cached.",
+                   PointerValue (),
+                   MakePointerAccessor (&CachingPropagationLossModel::SetLossModel,
+                                        &CachingPropagationLossModel::GetLossModel),
+                   MakePointerChecker<PropagationLossModel> ())
+    ;
+  return tid;
+}
+
+CachingPropagationLossModel::CachingPropagationLossModel ()
+  : m_deterministic (false)
+{}
+
+CachingPropagationLossModel::~CachingPropagationLossModel ()
+{}
+
+void
+CachingPropagationLossModel::DoDispose (void)
+{
+  m_cache.Clear ();
+  m_loss = 0;
+  PropagationLossModel::DoDispose ();
+}
+
+void
+CachingPropagationLossModel::SetLossModel (Ptr<PropagationLossModel> loss)
+{
+  m_cache.Clear ();
+  m_loss = loss;
+  m_deterministic = loss != 0 && loss->IsDeterministic ();
+  if (loss != 0 && !m_deterministic)
+    {
+      NS_LOG_WARN ("The reception powers of a non-deterministic model are not cached");
+    }
+}
+
+Ptr<PropagationLossModel>
+CachingPropagationLossModel::GetLossModel (void) const
+{
+  return m_loss;
+}
+
+double
+CachingPropagationLossModel::DoCalcRxPower (double txPowerDbm,
+                                            Ptr<MobilityModel> a,
+                                            Ptr<MobilityModel> b) const
+{
+  NS_ASSERT (m_loss != 0);
+  if (!m_deterministic)
+    {
+      return m_loss->CalcRxPower (txPowerDbm, a, b);
+    }
+  std::pair<double, double> cached;
+  if (m_cache.Lookup (a, b, &cached) && cached.first == txPowerDbm)
+    {
+      return cached.second;
+    }
+  double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, a, b);
+  m_cache.Add (a, b, std::make_pair (txPowerDbm, rxPowerDbm));
+  return rxPowerDbm;
+}
+
+bool
+CachingPropagationLossModel::DoIsDeterministic (void) const
+{
+  return m_deterministic;
+}
+
 } // namespace ns3
@@ -28,6 +28,7 @@
 #include "ns3/object.h"
 #include "ns3/random-variable.h"
 #include "ns3/node.h"
+#include "propagation-cache.h"
 #include <map>
 
 namespace ns3 {
@@ -59,12 +60,26 @@ public:
   double CalcRxPower (double txPowerDbm,
                       Ptr<MobilityModel> a,
                       Ptr<MobilityModel> b) const;
+  /**
+   * \returns true if this model and all the models chained after it
+   *          always return the same reception power for the same
+   *          transmission power and positions.
+   *
+   * Only the reception powers computed by deterministic models can
+   * be cached: see ns3::CachingPropagationLossModel.
+   */
+  bool IsDeterministic (void) const;
 private:
   PropagationLossModel (const PropagationLossModel &o);
   PropagationLossModel &operator = (const PropagationLossModel &o);
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const = 0;
+  /**
+   * The default implementation returns false: the subclasses which
+   * do not depend on random variables or on the time override it.
+   */
+  virtual bool DoIsDeterministic (void) const;
 
   Ptr<PropagationLossModel> m_next;
 };
@@ -177,6 +192,7 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual bool DoIsDeterministic (void) const;
   double DbmToW (double dbm) const;
   double DbmFromW (double w) const;
 
@@ -267,6 +283,7 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual bool DoIsDeterministic (void) const;
   double DbmToW (double dbm) const;
   double DbmFromW (double w) const;
 
@@ -319,6 +336,7 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual bool DoIsDeterministic (void) const;
   static Ptr<PropagationLossModel> CreateDefaultReference (void);
 
   double m_exponent;
@@ -380,6 +398,7 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual bool DoIsDeterministic (void) const;
 
   double m_distance0;
   double m_distance1;
@@ -462,6 +481,7 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual bool DoIsDeterministic (void) const;
   double m_rss;
 };
 
@@ -522,10 +542,55 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual bool DoIsDeterministic (void) const;
 private:
   double m_range;
 };
 
+/**
+ * \brief Cache the reception powers computed by another model.
+ *
+ * For each (source, destination) pair of mobility models, the last
+ * reception power computed by the wrapped model is stored and it is
+ * returned as long as the transmission power does not change and
+ * neither mobility model reports a course change. The pairs in which
+ * either node moves at a non-zero velocity are never cached, since
+ * their positions change without notification.
+ *
+ * Only deterministic models (see PropagationLossModel::IsDeterministic)
+ * are cached: the others, such as ns3::RandomPropagationLossModel or
+ * ns3::NakagamiPropagationLossModel, are always invoked. The
+ * parameters of the wrapped model must not change once it is used
+ * through this cache.
+ */
+class CachingPropagationLossModel : public PropagationLossModel
+{
+public:
+  static TypeId GetTypeId (void);
+  CachingPropagationLossModel ();
+  virtual ~CachingPropagationLossModel ();
+
+  /**
+   * \param loss the model whose results are cached.
+   */
+  void SetLossModel (Ptr<PropagationLossModel> loss);
+  Ptr<PropagationLossModel> GetLossModel (void) const;
+
+private:
+  CachingPropagationLossModel (const CachingPropagationLossModel &o);
+  CachingPropagationLossModel & operator = (const CachingPropagationLossModel &o);
+  virtual void DoDispose (void);
+  virtual double DoCalcRxPower (double txPowerDbm,
+                                Ptr<MobilityModel> a,
+                                Ptr<MobilityModel> b) const;
+  virtual bool DoIsDeterministic (void) const;
+
+  Ptr<PropagationLossModel> m_loss;
+  bool m_deterministic;
+  // the transmission power and the resulting reception power
+  mutable PropagationCache<std::pair<double, double> > m_cache;
+};
+
 } // namespace ns3
 
 #endif /* PROPAGATION_LOSS_MODEL_H */
@@ -22,6 +22,7 @@
 #include <ns3/assert.h>
 #include <ns3/log.h>
 #include <algorithm>
+#include <map>
 
 
 
@@ -41,21 +42,40 @@ SpectrumConverter::SpectrumConverter (Ptr<const SpectrumModel> fromSpectrumModel
 
   for (Bands::const_iterator toit = toSpectrumModel->Begin (); toit != toSpectrumModel->End (); ++toit)
     {
-      std::vector<double> coeffs;
-
-      for (Bands::const_iterator fromit = fromSpectrumModel->Begin (); fromit != fromSpectrumModel->End (); ++fromit)
+      m_rowStart.push_back (m_coefficient.size ());
+      uint32_t fromBand = 0;
+      for (Bands::const_iterator fromit = fromSpectrumModel->Begin (); fromit != fromSpectrumModel->End (); ++fromit, ++fromBand)
         {
           double c = GetCoefficient (*fromit, *toit);
           NS_LOG_LOGIC ("(" << fromit->fl << ","  << fromit->fh << ")"
                             << " --> " <<
                         "(" << toit->fl << "," << toit->fh << ")"
                             << " = " << c);
-          coeffs.push_back (c);
+          if (c != 0)
+            {
+              m_fromBand.push_back (fromBand);
+              m_coefficient.push_back (c);
+            }
         }
-
-      m_conversionMatrix.push_back (coeffs);
     }
+  m_rowStart.push_back (m_coefficient.size ());
+  NS_LOG_LOGIC ("non-zero coefficients: " << m_coefficient.size ());
+}
 
+Ptr<const SpectrumConverter>
+SpectrumConverter::Get (Ptr<const SpectrumModel> fromSpectrumModel, Ptr<const SpectrumModel> toSpectrumModel)
+{
+  typedef std::map<std::pair<SpectrumModelUid_t, SpectrumModelUid_t>, Ptr<const SpectrumConverter> > Converters;
+  static Converters converters;
+  std::pair<SpectrumModelUid_t, SpectrumModelUid_t> key (fromSpectrumModel->GetUid (), toSpectrumModel->GetUid ());
+  Converters::const_iterator i = converters.find (key);
+  if (i != converters.end ())
+    {
+      return i->second;
+    }
+  Ptr<const SpectrumConverter> converter = Create<SpectrumConverter> (fromSpectrumModel, toSpectrumModel);
+  converters[key] = converter;
+  return converter;
 }
 
 
@@ -78,23 +98,15 @@ SpectrumConverter::Convert (Ptr<const SpectrumValue> fvvf) const
   Ptr<SpectrumValue> tvvf = Create<SpectrumValue> (m_toSpectrumModel);
 
   Values::iterator tvit = tvvf->ValuesBegin ();
+  Values::const_iterator fvit = fvvf->ConstValuesBegin ();
 
-
-  for (std::vector<std::vector<double> >::const_iterator toit = m_conversionMatrix.begin ();
-       toit != m_conversionMatrix.end ();
-       ++toit)
+  for (uint32_t i = 0; i + 1 < m_rowStart.size (); ++i)
     {
       NS_ASSERT (tvit != tvvf->ValuesEnd ());
-      Values::const_iterator fvit = fvvf->ConstValuesBegin ();
-
       double sum = 0;
-      for (std::vector<double>::const_iterator fromit = toit->begin ();
-           fromit != toit->end ();
-           ++fromit)
+      for (uint32_t j = m_rowStart[i]; j < m_rowStart[i + 1]; ++j)
         {
-          NS_ASSERT (fvit != fvvf->ConstValuesEnd ());
-          sum += (*fvit) * (*fromit);
-          ++fvit;
+          sum += fvit[m_fromBand[j]] * m_coefficient[j];
         }
       *tvit = sum;
       ++tvit;
@@ -22,6 +22,7 @@
 #define SPECTRUM_CONVERTER_H
 
 #include <ns3/spectrum-value.h>
+#include <vector>
 
 
 namespace ns3 {
@@ -36,6 +37,10 @@ namespace ns3 {
  * and devices using a finer representation (e.g., one frequency for
  * each OFDM subcarrier).
  *
+ * The bands of two SpectrumModels usually overlap only pairwise, so the
+ * conversion matrix is mostly zeros: only its non-zero coefficients
+ * are stored, row by row, and Convert visits only those.
+ *
  */
 class SpectrumConverter : public SimpleRefCount<SpectrumConverter>
 {
@@ -51,7 +56,21 @@ public:
   SpectrumConverter (Ptr<const SpectrumModel> fromSpectrumModel, Ptr<const SpectrumModel> toSpectrumModel);
 
   SpectrumConverter ();
-  
+
+  /**
+   * Conversion matrices depend only on the two SpectrumModels, so the
+   * converters are shared by all the users of a pair of SpectrumModels:
+   * the first call for a pair creates its converter and the later
+   * calls return the same instance.
+   *
+   * @param fromSpectrumModel the SpectrumModel to convert from
+   * @param toSpectrumModel the SpectrumModel to convert to
+   *
+   * @return the converter from fromSpectrumModel to toSpectrumModel
+   */
+  static Ptr<const SpectrumConverter> Get (Ptr<const SpectrumModel> fromSpectrumModel,
+                                           Ptr<const SpectrumModel> toSpectrumModel);
+
 
 
   /**
@@ -76,7 +95,14 @@ private:
    */
   double GetCoefficient (const BandInfo& from, const BandInfo& to) const;
 
-  std::vector<std::vector<double> > m_conversionMatrix; // /< matrix of conversion coefficients
+  // the non-zero coefficients of the conversion matrix, in compressed
+  // row storage: the coefficients of the i-th band of the "to"
+  // SpectrumModel are at indexes m_rowStart[i] to m_rowStart[i+1] - 1
+  // of m_fromBand, the index of the band of the "from" SpectrumModel,
+  // and of m_coefficient.
+  std::vector<uint32_t> m_rowStart;
+  std::vector<uint32_t> m_fromBand;
+  std::vector<double> m_coefficient;
   Ptr<const SpectrumModel> m_fromSpectrumModel;  // /<  the SpectrumModel this SpectrumConverter instance can convert from
   Ptr<const SpectrumModel> m_toSpectrumModel;    // /<  the SpectrumModel this SpectrumConverter instance can convert to
 
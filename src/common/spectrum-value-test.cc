@@ -96,6 +96,38 @@ SpectrumValueTestCase::DoRun (void)
 
 
 
+class SpectrumValueIntegralTestCase : public TestCase
+{
+public:
+  SpectrumValueIntegralTestCase ();
+  virtual bool DoRun (void);
+};
+
+SpectrumValueIntegralTestCase::SpectrumValueIntegralTestCase ()
+  : TestCase ("Integral over bands of different widths")
+{
+}
+
+bool
+SpectrumValueIntegralTestCase::DoRun (void)
+{
+  // the bands are 1, 1.5 and 2 wide.
+  std::vector<double> freqs;
+  freqs.push_back (1);
+  freqs.push_back (2);
+  freqs.push_back (4);
+  Ptr<SpectrumModel> f = Create<SpectrumModel> (freqs);
+  SpectrumValue v (f);
+  v[0] = 1;
+  v[1] = 2;
+  v[2] = 3;
+  NS_TEST_ASSERT_MSG_EQ_TOL (Integral (v), 10, TOLERANCE, "Integral (v) is wrong");
+  NS_TEST_ASSERT_MSG_EQ_TOL (Sum (v), 6, TOLERANCE, "Sum (v) is wrong");
+  return GetErrorStatus ();
+}
+
+
+
 class SpectrumValueTestSuite : public TestSuite
 {
 public:
@@ -248,6 +280,19 @@ SpectrumValueTestSuite::SpectrumValueTestSuite ()
   AddTestCase (new SpectrumValueTestCase (tv9b, v9, "tv9b =  doubleValue * v1"));
   AddTestCase (new SpectrumValueTestCase (tv10b, v10, "tv10b = doubleValue / v1"));
 
+  SpectrumValue tv11 (f), tv12 (f);
+  tv11 = v1;
+  tv11.MultiplyAndAdd (v2, v3);
+  tv12 = v1 * v2 + v3;
+  AddTestCase (new SpectrumValueTestCase (tv11, tv12, "tv11.MultiplyAndAdd (v2, v3)"));
+
+  SpectrumValue tv13 (f), tv14 (f);
+  tv13 = Sinr (v2, v3, v10);
+  tv14 = v2 / (v3 - v2 + v10);
+  AddTestCase (new SpectrumValueTestCase (tv13, tv14, "tv13 = Sinr (v2, v3, v10)"));
+
+  AddTestCase (new SpectrumValueIntegralTestCase);
+
 
 
 
@@ -275,6 +320,36 @@ SpectrumValueTestSuite::SpectrumValueTestSuite ()
 
 
 
+class SpectrumConverterSharingTestCase : public TestCase
+{
+public:
+  SpectrumConverterSharingTestCase (Ptr<const SpectrumModel> a, Ptr<const SpectrumModel> b);
+  virtual bool DoRun (void);
+
+private:
+  Ptr<const SpectrumModel> m_a;
+  Ptr<const SpectrumModel> m_b;
+};
+
+SpectrumConverterSharingTestCase::SpectrumConverterSharingTestCase (Ptr<const SpectrumModel> a,
+                                                                    Ptr<const SpectrumModel> b)
+  : TestCase ("SpectrumConverter::Get shares one converter per pair of SpectrumModels"),
+    m_a (a),
+    m_b (b)
+{
+}
+
+bool
+SpectrumConverterSharingTestCase::DoRun (void)
+{
+  Ptr<const SpectrumConverter> ab = SpectrumConverter::Get (m_a, m_b);
+  NS_TEST_ASSERT_MSG_EQ (SpectrumConverter::Get (m_a, m_b), ab, "The converter is not shared");
+  NS_TEST_ASSERT_MSG_NE (SpectrumConverter::Get (m_b, m_a), ab, "The converters are not directed");
+  return GetErrorStatus ();
+}
+
+
+
 class SpectrumConverterTestSuite : public TestSuite
 {
 public:
@@ -353,6 +428,10 @@ SpectrumConverterTestSuite::SpectrumConverterTestSuite ()
 //   NS_LOG_LOGIC(*res);
   AddTestCase (new SpectrumValueTestCase (t21b, *res, ""));
 
+  res = SpectrumConverter::Get (sof2, sof1)->Convert (v2b);
+  AddTestCase (new SpectrumValueTestCase (t21b, *res, "shared converter"));
+  AddTestCase (new SpectrumConverterSharingTestCase (sof1, sof2));
+
 
 }
 
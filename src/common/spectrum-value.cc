@@ -104,17 +104,12 @@ SpectrumValue::ConstBandsEnd () const
 void
 SpectrumValue::Add (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
-
-  while (it1 != m_values.end ())
+  NS_ASSERT (m_values.size () == x.m_values.size ());
+  size_t n = m_values.size ();
+  for (size_t i = 0; i < n; i++)
     {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 += *it2;
-      ++it1;
-      ++it2;
+      m_values[i] += x.m_values[i];
     }
 }
 
@@ -122,12 +117,10 @@ SpectrumValue::Add (const SpectrumValue& x)
 void
 SpectrumValue::Add (double s)
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  size_t n = m_values.size ();
+  for (size_t i = 0; i < n; i++)
     {
-      *it1 += s;
-      ++it1;
+      m_values[i] += s;
     }
 }
 
@@ -136,17 +129,12 @@ SpectrumValue::Add (double s)
 void
 SpectrumValue::Subtract (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
-
-  while (it1 != m_values.end ())
+  NS_ASSERT (m_values.size () == x.m_values.size ());
+  size_t n = m_values.size ();
+  for (size_t i = 0; i < n; i++)
     {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 -= *it2;
-      ++it1;
-      ++it2;
+      m_values[i] -= x.m_values[i];
     }
 }
 
@@ -162,17 +150,12 @@ SpectrumValue::Subtract (double s)
 void
 SpectrumValue::Multiply (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
-
-  while (it1 != m_values.end ())
+  NS_ASSERT (m_values.size () == x.m_values.size ());
+  size_t n = m_values.size ();
+  for (size_t i = 0; i < n; i++)
     {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 *= *it2;
-      ++it1;
-      ++it2;
+      m_values[i] *= x.m_values[i];
     }
 }
 
@@ -180,12 +163,10 @@ SpectrumValue::Multiply (const SpectrumValue& x)
 void
 SpectrumValue::Multiply (double s)
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  size_t n = m_values.size ();
+  for (size_t i = 0; i < n; i++)
     {
-      *it1 *= s;
-      ++it1;
+      m_values[i] *= s;
     }
 }
 
@@ -195,17 +176,12 @@ SpectrumValue::Multiply (double s)
 void
 SpectrumValue::Divide (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
-
-  while (it1 != m_values.end ())
+  NS_ASSERT (m_values.size () == x.m_values.size ());
+  size_t n = m_values.size ();
+  for (size_t i = 0; i < n; i++)
     {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 /= *it2;
-      ++it1;
-      ++it2;
+      m_values[i] /= x.m_values[i];
     }
 }
 
@@ -214,12 +190,10 @@ void
 SpectrumValue::Divide (double s)
 {
   NS_LOG_FUNCTION (this << s);
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  size_t n = m_values.size ();
+  for (size_t i = 0; i < n; i++)
     {
-      *it1 /= s;
-      ++it1;
+      m_values[i] /= s;
     }
 }
 
@@ -229,12 +203,10 @@ SpectrumValue::Divide (double s)
 void
 SpectrumValue::ChangeSign ()
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  size_t n = m_values.size ();
+  for (size_t i = 0; i < n; i++)
     {
-      *it1 = -(*it1);
-      ++it1;
+      m_values[i] = -m_values[i];
     }
 }
 
@@ -346,11 +318,10 @@ double
 Norm (const SpectrumValue& x)
 {
   double s = 0;
-  Values::const_iterator it1 = x.ConstValuesBegin ();
-  while (it1 != x.ConstValuesEnd ())
+  size_t n = x.m_values.size ();
+  for (size_t i = 0; i < n; i++)
     {
-      s += (*it1) * (*it1);
-      ++it1;
+      s += x.m_values[i] * x.m_values[i];
     }
   return sqrt (s);
 }
@@ -360,11 +331,25 @@ double
 Sum (const SpectrumValue& x)
 {
   double s = 0;
-  Values::const_iterator it1 = x.ConstValuesBegin ();
-  while (it1 != x.ConstValuesEnd ())
+  size_t n = x.m_values.size ();
+  for (size_t i = 0; i < n; i++)
     {
-      s += (*it1);
-      ++it1;
+      s += x.m_values[i];
+    }
+  return s;
+}
+
+
+double
+Integral (const SpectrumValue& x)
+{
+  double s = 0;
+  Bands::const_iterator bi = x.ConstBandsBegin ();
+  size_t n = x.m_values.size ();
+  NS_ASSERT ((size_t)(x.ConstBandsEnd () - bi) == n);
+  for (size_t i = 0; i < n; i++, ++bi)
+    {
+      s += x.m_values[i] * (bi->fh - bi->fl);
     }
   return s;
 }
@@ -535,6 +520,24 @@ operator- (const SpectrumValue& rhs)
 }
 
 
+SpectrumValue
+Sinr (const SpectrumValue& signal, const SpectrumValue& allSignals, const SpectrumValue& noise)
+{
+  NS_ASSERT (signal.m_spectrumModel == allSignals.m_spectrumModel);
+  NS_ASSERT (signal.m_spectrumModel == noise.m_spectrumModel);
+  NS_ASSERT (signal.m_values.size () == allSignals.m_values.size ());
+  NS_ASSERT (signal.m_values.size () == noise.m_values.size ());
+  SpectrumValue res (signal.m_spectrumModel);
+  size_t n = res.m_values.size ();
+  for (size_t i = 0; i < n; i++)
+    {
+      res.m_values[i] = signal.m_values[i] /
+        (allSignals.m_values[i] - signal.m_values[i] + noise.m_values[i]);
+    }
+  return res;
+}
+
+
 SpectrumValue
 Pow (double lhs, const SpectrumValue& rhs)
 {
@@ -635,6 +638,22 @@ SpectrumValue:: operator/= (double rhs)
 }
 
 
+SpectrumValue&
+SpectrumValue::MultiplyAndAdd (const SpectrumValue& x, const SpectrumValue& y)
+{
+  NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  NS_ASSERT (m_spectrumModel == y.m_spectrumModel);
+  NS_ASSERT (m_values.size () == x.m_values.size ());
+  NS_ASSERT (m_values.size () == y.m_values.size ());
+  size_t n = m_values.size ();
+  for (size_t i = 0; i < n; i++)
+    {
+      m_values[i] = m_values[i] * x.m_values[i] + y.m_values[i];
+    }
+  return *this;
+}
+
+
 SpectrumValue&
 SpectrumValue:: operator= (double rhs)
 {
@@ -398,6 +398,19 @@ public:
    */
   SpectrumValue& operator= (double rhs);
 
+  /**
+   * Multiply *this by x and add y, component by component, in a
+   * single pass and without any temporary SpectrumValue: this is
+   * equivalent to *this = *this * x + y, e.g., to apply a propagation
+   * loss to a received power spectral density and add the noise.
+   *
+   * @param x the values by which *this is multiplied
+   * @param y the values which are added to the products
+   *
+   * @return a reference to *this
+   */
+  SpectrumValue& MultiplyAndAdd (const SpectrumValue& x, const SpectrumValue& y);
+
 
 
   /**
@@ -428,6 +441,30 @@ public:
    */
   friend double Prod (const SpectrumValue& x);
 
+  /**
+   * @param x the operand
+   *
+   * @return the integral of x over the frequencies of its
+   * SpectrumModel, i.e., the sum of the values in x weighted by the
+   * width of their bands
+   */
+  friend double Integral (const SpectrumValue& x);
+
+  /**
+   * Compute signal / (allSignals - signal + noise), component by
+   * component, in a single pass and with a single allocation instead
+   * of the three temporaries of the equivalent expression.
+   *
+   * @param signal the power spectral density of the signal of interest
+   * @param allSignals the sum of the power spectral densities of all
+   * the signals, including the signal of interest
+   * @param noise the power spectral density of the noise
+   *
+   * @return the signal to interference plus noise ratio
+   */
+  friend SpectrumValue Sinr (const SpectrumValue& signal, const SpectrumValue& allSignals,
+                             const SpectrumValue& noise);
+
 
   /**
    *
@@ -524,6 +561,9 @@ std::ostream& operator << (std::ostream& os, const SpectrumValue& pvf);
 double Norm (const SpectrumValue& x);
 double Sum (const SpectrumValue& x);
 double Prod (const SpectrumValue& x);
+double Integral (const SpectrumValue& x);
+SpectrumValue Sinr (const SpectrumValue& signal, const SpectrumValue& allSignals,
+                    const SpectrumValue& noise);
 SpectrumValue Pow (const SpectrumValue& base, double exp);
 SpectrumValue Pow (double base, const SpectrumValue& exp);
 SpectrumValue Log10 (const SpectrumValue&  arg);
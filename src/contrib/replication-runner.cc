@@ -0,0 +1,435 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "replication-runner.h"
+#include "average.h"
+#include "ns3/random-variable.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <set>
+#include <errno.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+NS_LOG_COMPONENT_DEFINE ("ReplicationRunner");
+
+namespace ns3 {
+
+namespace {
+struct Child
+{
+  pid_t pid;
+  uint32_t run;
+  // the results read so far from the pipe of the child
+  std::string buffer;
+};
+} // anonymous namespace
+
+// the values recorded by the replication which runs in this process.
+static std::map<std::string, double> *g_record = 0;
+
+/*
+ * The two-sided 95% quantiles of the Student t distribution for 1 to
+ * 30 degrees of freedom. Above, the quantile of the normal distribution
+ * is used.
+ */
+static const double g_student95[] = {
+  12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+  2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+  2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+};
+
+ReplicationRunner::ReplicationRunner ()
+  : m_replications (1),
+    m_firstRun (0),
+    m_jobs (0),
+    m_failed (0)
+{}
+
+void
+ReplicationRunner::SetReplications (uint32_t n)
+{
+  m_replications = n;
+}
+
+void
+ReplicationRunner::SetFirstRun (uint32_t run)
+{
+  m_firstRun = run;
+}
+
+void
+ReplicationRunner::SetJobs (uint32_t jobs)
+{
+  m_jobs = jobs;
+}
+
+void
+ReplicationRunner::Record (std::string name, double value)
+{
+  NS_ASSERT_MSG (g_record != 0, "ReplicationRunner::Record called outside of a replication");
+  NS_ASSERT_MSG (name.find_first_of (" \n") == std::string::npos, "Invalid result name \"" << name << "\"");
+  (*g_record)[name] = value;
+}
+
+void
+ReplicationRunner::RunChild (Callback<void, uint32_t> replication, uint32_t run, int fd)
+{
+  Values values;
+  g_record = &values;
+  SeedManager::SetRun (run);
+  replication (run);
+  g_record = 0;
+
+  std::ostringstream oss;
+  oss << std::setprecision (17);
+  for (Values::const_iterator i = values.begin (); i != values.end (); i++)
+    {
+      oss << i->first << " " << i->second << std::endl;
+    }
+  std::string buffer = oss.str ();
+  const char *data = buffer.c_str ();
+  size_t left = buffer.size ();
+  while (left > 0)
+    {
+      ssize_t written = write (fd, data, left);
+      if (written < 0 && errno == EINTR)
+        {
+          continue;
+        }
+      if (written <= 0)
+        {
+          _exit (1);
+        }
+      data += written;
+      left -= written;
+    }
+  close (fd);
+  std::cout.flush ();
+  std::cerr.flush ();
+  // do not run the destructors of the static objects inherited
+  // from the parent process.
+  _exit (0);
+}
+
+bool
+ReplicationRunner::Parse (std::string buffer, Values &values)
+{
+  std::istringstream iss (buffer);
+  std::string name, text;
+  // the NaNs are written as "nan", which operator>> does not parse.
+  while (iss >> name >> text)
+    {
+      char *end;
+      double value = strtod (text.c_str (), &end);
+      if (*end != 0)
+        {
+          return false;
+        }
+      values[name] = value;
+    }
+  return iss.eof ();
+}
+
+void
+ReplicationRunner::Run (Callback<void, uint32_t> replication)
+{
+  uint32_t jobs = m_jobs;
+  if (jobs == 0)
+    {
+      long n = sysconf (_SC_NPROCESSORS_ONLN);
+      jobs = (n > 0) ? n : 1;
+    }
+  NS_LOG_FUNCTION (this << m_replications << jobs);
+
+  // the children which are still running, indexed by the read
+  // end of their pipe.
+  std::map<int, Child> children;
+  m_results.clear ();
+  m_failed = 0;
+  uint32_t next = 0;
+  while (next < m_replications || !children.empty ())
+    {
+      while (next < m_replications && children.size () < jobs)
+        {
+          uint32_t run = m_firstRun + next;
+          next++;
+          int fds[2];
+          if (pipe (fds) != 0)
+            {
+              NS_FATAL_ERROR ("ReplicationRunner::Run(): pipe() fails, errno = " << strerror (errno));
+            }
+          // make sure the child does not output again what the parent
+          // buffered before the fork.
+          std::cout.flush ();
+          std::cerr.flush ();
+          pid_t pid = fork ();
+          if (pid < 0)
+            {
+              NS_FATAL_ERROR ("ReplicationRunner::Run(): fork() fails, errno = " << strerror (errno));
+            }
+          if (pid == 0)
+            {
+              close (fds[0]);
+              for (std::map<int, Child>::const_iterator i = children.begin (); i != children.end (); i++)
+                {
+                  close (i->first);
+                }
+              RunChild (replication, run, fds[1]);
+            }
+          NS_LOG_LOGIC ("run " << run << " started in process " << pid);
+          close (fds[1]);
+          Child child;
+          child.pid = pid;
+          child.run = run;
+          children[fds[0]] = child;
+        }
+
+      std::vector<struct pollfd> polled;
+      for (std::map<int, Child>::const_iterator i = children.begin (); i != children.end (); i++)
+        {
+          struct pollfd p;
+          p.fd = i->first;
+          p.events = POLLIN;
+          p.revents = 0;
+          polled.push_back (p);
+        }
+      if (poll (&polled[0], polled.size (), -1) < 0)
+        {
+          if (errno == EINTR)
+            {
+              continue;
+            }
+          NS_FATAL_ERROR ("ReplicationRunner::Run(): poll() fails, errno = " << strerror (errno));
+        }
+      for (std::vector<struct pollfd>::const_iterator i = polled.begin (); i != polled.end (); i++)
+        {
+          if (i->revents == 0)
+            {
+              continue;
+            }
+          Child &child = children[i->fd];
+          char data[4096];
+          ssize_t n = read (i->fd, data, sizeof (data));
+          if (n < 0 && errno == EINTR)
+            {
+              continue;
+            }
+          if (n > 0)
+            {
+              child.buffer.append (data, n);
+              continue;
+            }
+          // end of file: the child has exited or is about to.
+          close (i->fd);
+          int status;
+          while (waitpid (child.pid, &status, 0) < 0 && errno == EINTR)
+            {
+            }
+          Values values;
+          if (WIFEXITED (status) && WEXITSTATUS (status) == 0 && Parse (child.buffer, values))
+            {
+              NS_LOG_LOGIC ("run " << child.run << " completed");
+              m_results[child.run] = values;
+            }
+          else
+            {
+              NS_LOG_WARN ("run " << child.run << " failed with status " << status);
+              m_failed++;
+            }
+          children.erase (i->fd);
+        }
+    }
+}
+
+uint32_t
+ReplicationRunner::GetNFailed (void) const
+{
+  return m_failed;
+}
+
+std::vector<std::string>
+ReplicationRunner::GetNames (void) const
+{
+  std::set<std::string> names;
+  for (Results::const_iterator i = m_results.begin (); i != m_results.end (); i++)
+    {
+      for (Values::const_iterator j = i->second.begin (); j != i->second.end (); j++)
+        {
+          names.insert (j->first);
+        }
+    }
+  return std::vector<std::string> (names.begin (), names.end ());
+}
+
+std::vector<double>
+ReplicationRunner::GetValues (std::string name) const
+{
+  std::vector<double> values;
+  for (Results::const_iterator i = m_results.begin (); i != m_results.end (); i++)
+    {
+      Values::const_iterator j = i->second.find (name);
+      if (j != i->second.end ())
+        {
+          values.push_back (j->second);
+        }
+    }
+  return values;
+}
+
+struct ReplicationRunner::Summary
+ReplicationRunner::GetSummary (std::string name) const
+{
+  std::vector<double> values = GetValues (name);
+  Average<double> average;
+  for (std::vector<double>::const_iterator i = values.begin (); i != values.end (); i++)
+    {
+      // skip the NaNs
+      if (*i == *i)
+        {
+          average.Update (*i);
+        }
+    }
+  struct Summary summary;
+  summary.count = average.Count ();
+  summary.mean = average.Mean ();
+  summary.min = average.Min ();
+  summary.max = average.Max ();
+  summary.stddev = 0;
+  summary.ci95 = 0;
+  if (summary.count > 1)
+    {
+      summary.stddev = average.Stddev ();
+      uint32_t df = summary.count - 1;
+      double t = (df <= sizeof (g_student95) / sizeof (g_student95[0])) ? g_student95[df - 1] : 1.960;
+      summary.ci95 = t * summary.stddev / sqrt ((double)summary.count);
+    }
+  return summary;
+}
+
+void
+ReplicationRunner::Print (std::ostream &os) const
+{
+  std::vector<std::string> names = GetNames ();
+  for (std::vector<std::string>::const_iterator i = names.begin (); i != names.end (); i++)
+    {
+      struct Summary summary = GetSummary (*i);
+      os << *i << ": " << summary.mean << " +/- " << summary.ci95
+         << " (95% ci, n=" << summary.count << ", stddev=" << summary.stddev
+         << ", min=" << summary.min << ", max=" << summary.max << ")" << std::endl;
+    }
+  if (m_failed != 0)
+    {
+      os << m_failed << " replication(s) failed" << std::endl;
+    }
+}
+
+} // namespace ns3
+
+#include "ns3/test.h"
+#include <limits>
+
+namespace ns3 {
+
+class ReplicationRunnerTestCase : public TestCase
+{
+public:
+  ReplicationRunnerTestCase ();
+private:
+  virtual bool DoRun (void);
+  static void Replication (uint32_t run);
+};
+
+ReplicationRunnerTestCase::ReplicationRunnerTestCase ()
+  : TestCase ("Check that replications run in isolation with their own run number")
+{}
+
+void
+ReplicationRunnerTestCase::Replication (uint32_t run)
+{
+  ReplicationRunner::Record ("run", run);
+  ReplicationRunner::Record ("seed-run", SeedManager::GetRun ());
+  if (run % 2 == 0)
+    {
+      ReplicationRunner::Record ("even", 1.0 / 3);
+    }
+  ReplicationRunner::Record ("odd", (run % 2 == 1) ? run : std::numeric_limits<double>::quiet_NaN ());
+  if (run == 7)
+    {
+      _exit (3);
+    }
+}
+
+bool
+ReplicationRunnerTestCase::DoRun (void)
+{
+  uint32_t previousRun = SeedManager::GetRun ();
+  ReplicationRunner runner;
+  runner.SetReplications (6);
+  runner.SetFirstRun (3);
+  runner.SetJobs (4);
+  runner.Run (MakeCallback (&ReplicationRunnerTestCase::Replication));
+
+  NS_TEST_EXPECT_MSG_EQ (SeedManager::GetRun (), previousRun, "The run number of the parent was modified");
+  NS_TEST_EXPECT_MSG_EQ (runner.GetNFailed (), 1, "The failed replication was not detected");
+  std::vector<double> runs = runner.GetValues ("run");
+  std::vector<double> seedRuns = runner.GetValues ("seed-run");
+  NS_TEST_ASSERT_MSG_EQ (runs.size (), 5, "Unexpected number of results");
+  double expected[] = { 3, 4, 5, 6, 8 };
+  for (uint32_t i = 0; i < runs.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (runs[i], expected[i], "Unexpected result order");
+      NS_TEST_EXPECT_MSG_EQ (seedRuns[i], expected[i], "SeedManager::SetRun was not called");
+    }
+  std::vector<double> even = runner.GetValues ("even");
+  NS_TEST_ASSERT_MSG_EQ (even.size (), 3, "Unexpected number of results");
+  NS_TEST_EXPECT_MSG_EQ (even[0], 1.0 / 3, "Values must be transferred without loss of precision");
+  std::vector<double> odd = runner.GetValues ("odd");
+  NS_TEST_ASSERT_MSG_EQ (odd.size (), 5, "The NaNs must be kept in the results");
+  NS_TEST_EXPECT_MSG_EQ ((odd[1] != odd[1]), true, "Expected a NaN for run 4");
+  NS_TEST_EXPECT_MSG_EQ (odd[2], 5, "Unexpected result order");
+  NS_TEST_EXPECT_MSG_EQ (runner.GetSummary ("odd").count, 2, "The NaNs must not be summarized");
+  NS_TEST_EXPECT_MSG_EQ_TOL (runner.GetSummary ("odd").mean, 4, 1e-9, "The NaNs must not be summarized");
+
+  ReplicationRunner::Summary summary = runner.GetSummary ("run");
+  NS_TEST_EXPECT_MSG_EQ (summary.count, 5, "Unexpected sample size");
+  NS_TEST_EXPECT_MSG_EQ_TOL (summary.mean, 5.2, 1e-9, "Unexpected mean");
+  NS_TEST_EXPECT_MSG_EQ_TOL (summary.stddev, 1.9235384061671346, 1e-9, "Unexpected standard deviation");
+  NS_TEST_EXPECT_MSG_EQ_TOL (summary.ci95, 2.776 * 1.9235384061671346 / sqrt (5.0), 1e-9, "Unexpected confidence interval");
+  NS_TEST_EXPECT_MSG_EQ (summary.min, 3, "Unexpected minimum");
+  NS_TEST_EXPECT_MSG_EQ (summary.max, 8, "Unexpected maximum");
+  return false;
+}
+
+static class ReplicationRunnerTestSuite : public TestSuite
+{
+public:
+  ReplicationRunnerTestSuite ()
+    : TestSuite ("replication-runner", UNIT)
+  {
+    AddTestCase (new ReplicationRunnerTestCase ());
+  }
+} g_replicationRunnerTestSuite;
+
+} // namespace ns3
@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef REPLICATION_RUNNER_H
+#define REPLICATION_RUNNER_H
+
+#include "ns3/callback.h"
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+#include <ostream>
+
+namespace ns3 {
+
+/**
+ * \brief run independent replications of an experiment in parallel
+ *
+ * The Simulator, the NodeList and most of the models rely on global
+ * state so that two simulations cannot run concurrently in the same
+ * process. This class runs each replication in a child process
+ * obtained with fork: the replication starts from the state of the
+ * parent process, with SeedManager::SetRun called with its own run
+ * number, and it cannot interfere with the other replications.
+ *
+ * A replication reports its results with ReplicationRunner::Record,
+ * as a set of named values. Once all the replications have completed,
+ * the values of each name are summarized by their mean and the
+ * confidence interval of the mean.
+ *
+ * \code
+ *   void Experiment (uint32_t run)
+ *   {
+ *     // ... build and run the simulation ...
+ *     ReplicationRunner::Record ("pdr", pdr);
+ *     Simulator::Destroy ();
+ *   }
+ *
+ *   ReplicationRunner runner;
+ *   runner.SetReplications (10);
+ *   runner.Run (MakeCallback (&Experiment));
+ *   runner.Print (std::cout);
+ * \endcode
+ *
+ * The parent process must not have started any thread before calling
+ * Run: in practice, it should not create any simulation object.
+ */
+class ReplicationRunner
+{
+public:
+  /**
+   * \brief the summary of the values recorded under a name
+   */
+  struct Summary
+  {
+    // number of replications which recorded a value
+    uint32_t count;
+    double mean;
+    double stddev;
+    // half-width of the 95% confidence interval of the mean
+    double ci95;
+    double min;
+    double max;
+  };
+
+  ReplicationRunner ();
+
+  /**
+   * \param n the number of replications to run.
+   */
+  void SetReplications (uint32_t n);
+  /**
+   * \param run the run number of the first replication: replication i
+   *        uses run number run + i.
+   */
+  void SetFirstRun (uint32_t run);
+  /**
+   * \param jobs the maximum number of replications run concurrently.
+   *        If zero, the number of online processors is used.
+   */
+  void SetJobs (uint32_t jobs);
+
+  /**
+   * \param replication the function which runs one replication. It
+   *        is called in a child process with the run number of the
+   *        replication, which was already passed to SeedManager::SetRun.
+   *
+   * Run all the replications and collect their results. This returns
+   * once all of them have completed.
+   */
+  void Run (Callback<void, uint32_t> replication);
+
+  /**
+   * \param name the name of a result
+   * \param value the value of this result in the current replication
+   *
+   * This must be called from within the replication callback. A
+   * replication which has no meaningful value for a result it
+   * records in other replications should record a NaN: the values
+   * returned by GetValues then stay aligned with the replications
+   * while GetSummary ignores the NaNs.
+   */
+  static void Record (std::string name, double value);
+
+  /**
+   * \returns the number of replications which did not complete
+   *          successfully during the last call to Run.
+   */
+  uint32_t GetNFailed (void) const;
+  /**
+   * \returns the names of all the results recorded by the replications.
+   */
+  std::vector<std::string> GetNames (void) const;
+  /**
+   * \param name the name of a result
+   * \returns the values recorded under this name, ordered by run number.
+   */
+  std::vector<double> GetValues (std::string name) const;
+  /**
+   * \param name the name of a result
+   * \returns the summary of the values recorded under this name,
+   *          not counting the NaNs.
+   */
+  struct Summary GetSummary (std::string name) const;
+  /**
+   * \param os the output stream
+   *
+   * Print one line per result with its summary.
+   */
+  void Print (std::ostream &os) const;
+
+private:
+  typedef std::map<std::string, double> Values;
+  typedef std::map<uint32_t, Values> Results;
+
+  void RunChild (Callback<void, uint32_t> replication, uint32_t run, int fd);
+  static bool Parse (std::string buffer, Values &values);
+
+  uint32_t m_replications;
+  uint32_t m_firstRun;
+  uint32_t m_jobs;
+  uint32_t m_failed;
+  Results m_results;
+};
+
+} // namespace ns3
+
+#endif /* REPLICATION_RUNNER_H */
@@ -35,6 +35,7 @@
 #include "ie-dot11s-prep.h"
 #include "ns3/trace-source-accessor.h"
 #include "ie-dot11s-perr.h"
+#include <algorithm>
 
 NS_LOG_COMPONENT_DEFINE ("HwmpProtocol");
 
@@ -174,6 +175,7 @@ HwmpProtocol::HwmpProtocol ():
   m_preqId (0),
   m_rtable (CreateObject<HwmpRtable> ()),
   m_randomStart(Seconds (0.1)),
+  m_nextArrival (0),
   m_maxQueueSize (255),
   m_dot11MeshHWMPmaxPREQretries (3),
   m_dot11MeshHWMPnetDiameterTraversalTime (MicroSeconds (1024*100)),
@@ -218,6 +220,7 @@ HwmpProtocol::DoDispose ()
   m_hwmpSeqnoMetricDatabase.clear ();
   m_interfaces.clear ();
   m_rqueue.clear ();
+  m_rqueueArrivals.clear ();
   m_rtable = 0;
   m_mp = 0;
 }
@@ -422,11 +425,12 @@ HwmpProtocol::ReceivePreq (IePreq preq, Mac48Address from, uint32_t interface, M
   NS_LOG_DEBUG("I am " << GetAddress () << "Accepted preq from address" << from << ", preq:" << preq);
   std::vector<Ptr<DestinationAddressUnit> > destinations = preq.GetDestinationList ();
   //Add reactive path to originator:
+  HwmpRtable::LookupResult originatorRoute = m_rtable->LookupReactive (preq.GetOriginatorAddress ());
   if (
       (freshInfo) ||
       (
-        (m_rtable->LookupReactive (preq.GetOriginatorAddress ()).retransmitter == Mac48Address::GetBroadcast ()) ||
-        (m_rtable->LookupReactive (preq.GetOriginatorAddress ()).metric > preq.GetMetric ())
+        (originatorRoute.retransmitter == Mac48Address::GetBroadcast ()) ||
+        (originatorRoute.metric > preq.GetMetric ())
       )
      )
     {
@@ -436,13 +440,15 @@ HwmpProtocol::ReceivePreq (IePreq preq, Mac48Address from, uint32_t interface, M
           interface,
           preq.GetMetric (),
           MicroSeconds (preq.GetLifetime () * 1024),
-          preq.GetOriginatorSeqNumber ()
+          preq.GetOriginatorSeqNumber (),
+          preq.GetHopCount ()
         );
       ReactivePathResolved (preq.GetOriginatorAddress ());
     }
+  HwmpRtable::LookupResult fromMpRoute = m_rtable->LookupReactive (fromMp);
   if (
-      (m_rtable->LookupReactive (fromMp).retransmitter == Mac48Address::GetBroadcast ()) ||
-      (m_rtable->LookupReactive (fromMp).metric > metric)
+      (fromMpRoute.retransmitter == Mac48Address::GetBroadcast ()) ||
+      (fromMpRoute.metric > metric)
       )
     {
       m_rtable->AddReactivePath (
@@ -451,7 +457,8 @@ HwmpProtocol::ReceivePreq (IePreq preq, Mac48Address from, uint32_t interface, M
           interface,
           metric,
           MicroSeconds (preq.GetLifetime () * 1024),
-          preq.GetOriginatorSeqNumber ()
+          preq.GetOriginatorSeqNumber (),
+          1
           );
       ReactivePathResolved (fromMp);
     }
@@ -467,9 +474,10 @@ HwmpProtocol::ReceivePreq (IePreq preq, Mac48Address from, uint32_t interface, M
           NS_ASSERT (((*i)->IsDo ()) && ((*i)->IsRf ()));
           //Add proactive path only if it is the better then existed
           //before
+          HwmpRtable::LookupResult rootRoute = m_rtable->LookupProactive ();
           if (
-              ((m_rtable->LookupProactive ()).retransmitter == Mac48Address::GetBroadcast ()) ||
-              ((m_rtable->LookupProactive ()).metric > preq.GetMetric ())
+              (rootRoute.retransmitter == Mac48Address::GetBroadcast ()) ||
+              (rootRoute.metric > preq.GetMetric ())
             )
             {
               m_rtable->AddProactivePath (
@@ -478,7 +486,8 @@ HwmpProtocol::ReceivePreq (IePreq preq, Mac48Address from, uint32_t interface, M
                   from,
                   interface,
                   MicroSeconds (preq.GetLifetime () * 1024),
-                  preq.GetOriginatorSeqNumber ()
+                  preq.GetOriginatorSeqNumber (),
+                  preq.GetHopCount ()
                   );
               ProactivePathResolved ();
             }
@@ -583,11 +592,12 @@ HwmpProtocol::ReceivePrep (IePrep prep, Mac48Address from, uint32_t interface, M
   HwmpRtable::LookupResult result = m_rtable->LookupReactive (prep.GetDestinationAddress ());
   //Add a reactive path only if seqno is fresher or it improves the
   //metric
+  HwmpRtable::LookupResult originatorRoute = m_rtable->LookupReactive (prep.GetOriginatorAddress ());
   if (
       (freshInfo) ||
       (
-       ((m_rtable->LookupReactive (prep.GetOriginatorAddress ())).retransmitter == Mac48Address::GetBroadcast ()) ||
-       ((m_rtable->LookupReactive (prep.GetOriginatorAddress ())).metric > prep.GetMetric ())
+       (originatorRoute.retransmitter == Mac48Address::GetBroadcast ()) ||
+       (originatorRoute.metric > prep.GetMetric ())
       )
      )
     {
@@ -597,7 +607,8 @@ HwmpProtocol::ReceivePrep (IePrep prep, Mac48Address from, uint32_t interface, M
           interface,
           prep.GetMetric (),
           MicroSeconds (prep.GetLifetime () * 1024),
-          prep.GetOriginatorSeqNumber ());
+          prep.GetOriginatorSeqNumber (),
+          prep.GetHopcount ());
       m_rtable->AddPrecursor (prep.GetDestinationAddress (), interface, from,
           MicroSeconds (prep.GetLifetime () * 1024));
       if (result.retransmitter != Mac48Address::GetBroadcast ())
@@ -607,9 +618,10 @@ HwmpProtocol::ReceivePrep (IePrep prep, Mac48Address from, uint32_t interface, M
         }
       ReactivePathResolved (prep.GetOriginatorAddress ());
     }
+  HwmpRtable::LookupResult fromMpRoute = m_rtable->LookupReactive (fromMp);
   if (
-      ((m_rtable->LookupReactive (fromMp)).retransmitter == Mac48Address::GetBroadcast ()) ||
-      ((m_rtable->LookupReactive (fromMp)).metric > metric)
+      (fromMpRoute.retransmitter == Mac48Address::GetBroadcast ()) ||
+      (fromMpRoute.metric > metric)
       )
     {
       m_rtable->AddReactivePath (
@@ -618,7 +630,8 @@ HwmpProtocol::ReceivePrep (IePrep prep, Mac48Address from, uint32_t interface, M
           interface,
           metric,
           MicroSeconds(prep.GetLifetime () * 1024),
-          prep.GetOriginatorSeqNumber ());
+          prep.GetOriginatorSeqNumber (),
+          1);
       ReactivePathResolved (fromMp);
     }
   if (prep.GetDestinationAddress () == GetAddress ())
@@ -710,6 +723,7 @@ HwmpProtocol::Install (Ptr<MeshPointDevice> mp)
       //Installing airtime link metric:
       Ptr<AirtimeLinkMetricCalculator> metric = CreateObject <AirtimeLinkMetricCalculator> ();
       mac->SetLinkMetricCallback (MakeCallback (&AirtimeLinkMetricCalculator::CalculateMetric, metric));
+      mac->SetHopCountCallback (MakeCallback (&HwmpProtocol::GetHopCount, this));
     }
   mp->SetRoutingProtocol (this);
   // Mesh point aggregates all installed protocols
@@ -717,6 +731,24 @@ HwmpProtocol::Install (Ptr<MeshPointDevice> mp)
   m_address = Mac48Address::ConvertFrom (mp->GetAddress ());// address;
   return true;
 }
+uint32_t
+HwmpProtocol::GetHopCount (Mac48Address destination)
+{
+  if (destination.IsGroup ())
+    {
+      return 0;
+    }
+  HwmpRtable::LookupResult result = m_rtable->LookupReactive (destination);
+  if (result.retransmitter == Mac48Address::GetBroadcast ())
+    {
+      result = m_rtable->LookupProactive ();
+    }
+  if (result.retransmitter == Mac48Address::GetBroadcast ())
+    {
+      return 0;
+    }
+  return result.hopcount;
+}
 void
 HwmpProtocol::PeerLinkStatus(Mac48Address meshPointAddress, Mac48Address peerAddress, uint32_t interface, bool status)
 {
@@ -866,11 +898,16 @@ HwmpProtocol::GetBroadcastReceivers (uint32_t interface)
 bool
 HwmpProtocol::QueuePacket (QueuedPacket packet)
 {
-  if (m_rqueue.size () > m_maxQueueSize)
+  if (m_rqueueArrivals.size () >= m_maxQueueSize)
     {
+      m_stats.droppedQueueFull ++;
       return false;
     }
-  m_rqueue.push_back (packet);
+  packet.arrival = m_nextArrival++;
+  m_rqueue[packet.dst].push_back (packet);
+  m_rqueueArrivals[packet.arrival] = packet.dst;
+  m_stats.maxQueued = std::max<uint16_t> (m_stats.maxQueued, m_rqueueArrivals.size ());
+  m_stats.maxQueuedDestinations = std::max<uint16_t> (m_stats.maxQueuedDestinations, m_rqueue.size ());
   return true;
 }
 
@@ -879,14 +916,16 @@ HwmpProtocol::DequeueFirstPacketByDst (Mac48Address dst)
 {
   QueuedPacket retval;
   retval.pkt = 0;
-  for (std::vector<QueuedPacket>::iterator i = m_rqueue.begin (); i != m_rqueue.end (); i++)
+  std::map<Mac48Address, std::deque<QueuedPacket> >::iterator i = m_rqueue.find (dst);
+  if (i != m_rqueue.end ())
     {
-      if ((*i).dst == dst)
+      retval = i->second.front ();
+      i->second.pop_front ();
+      if (i->second.empty ())
         {
-          retval = (*i);
           m_rqueue.erase (i);
-          break;
         }
+      m_rqueueArrivals.erase (retval.arrival);
     }
   return retval;
 }
@@ -896,10 +935,10 @@ HwmpProtocol::DequeueFirstPacket ()
 {
   QueuedPacket retval;
   retval.pkt = 0;
-  if (m_rqueue.size () != 0)
+  if (m_rqueueArrivals.size () != 0)
     {
-      retval = m_rqueue[0];
-      m_rqueue.erase (m_rqueue.begin ());
+      // The first packet to arrive is the first one queued for its destination
+      retval = DequeueFirstPacketByDst (m_rqueueArrivals.begin ()->second);
     }
   return retval;
 }
@@ -1107,6 +1146,9 @@ HwmpProtocol::Statistics::Statistics () :
   droppedTtl (0),
   totalQueued (0),
   totalDropped (0),
+  droppedQueueFull (0),
+  maxQueued (0),
+  maxQueuedDestinations (0),
   initiatedPreq (0),
   initiatedPrep (0),
   initiatedPerr (0)
@@ -1120,6 +1162,9 @@ void HwmpProtocol::Statistics::Print (std::ostream & os) const
     "droppedTtl=\"" << droppedTtl << "\" "
     "totalQueued=\"" << totalQueued << "\" "
     "totalDropped=\"" << totalDropped << "\" "
+    "droppedQueueFull=\"" << droppedQueueFull << "\" "
+    "maxQueued=\"" << maxQueued << "\" "
+    "maxQueuedDestinations=\"" << maxQueuedDestinations << "\" "
     "initiatedPreq=\"" << initiatedPreq << "\" "
     "initiatedPrep=\"" << initiatedPrep << "\" "
     "initiatedPerr=\"" << initiatedPerr << "\"/>" << std::endl;
@@ -1146,6 +1191,9 @@ HwmpProtocol::Report (std::ostream & os) const
     "doFlag=\"" << m_doFlag << "\"" << std::endl <<
     "rfFlag=\"" << m_rfFlag << "\">" << std::endl;
   m_stats.Print (os);
+  os << "<Queue "
+    "queued=\"" << m_rqueueArrivals.size () << "\" "
+    "destinations=\"" << m_rqueue.size () << "\"/>" << std::endl;
   for (HwmpProtocolMacMap::const_iterator plugin = m_interfaces.begin (); plugin != m_interfaces.end (); plugin ++)
     {
       plugin->second->Report (os);
@@ -1164,7 +1212,8 @@ HwmpProtocol::ResetStats ()
 HwmpProtocol::QueuedPacket::QueuedPacket () :
   pkt (0),
   protocol (0),
-  inInterface (0)
+  inInterface (0),
+  arrival (0)
 {}
 } //namespace dot11s
 } //namespace ns3
@@ -26,6 +26,7 @@
 #include "ns3/event-id.h"
 #include "ns3/traced-value.h"
 #include <vector>
+#include <deque>
 #include <map>
 
 namespace ns3 {
@@ -74,6 +75,12 @@ public:
    */
   bool Install (Ptr<MeshPointDevice>);
   void PeerLinkStatus (Mac48Address meshPontAddress, Mac48Address peerAddress, uint32_t interface,bool status);
+  /**
+   * \returns the number of hops of the path to <i>destination</i>, which
+   * is the path to the root when there is no reactive path, or 0 if
+   * there is no path.
+   */
+  uint32_t GetHopCount (Mac48Address destination);
   ///\brief This callback is used to obtain active neighbours on a given interface
   ///\param cb is a callback, which returns a list of addresses on given interface (uint32_t)  
   void SetNeighboursCallback (Callback<std::vector<Mac48Address>, uint32_t> cb);
@@ -87,6 +94,7 @@ public:
   void ResetStats ();
 private:
   friend class HwmpProtocolMac;
+  friend class HwmpProtocolQueueTest;
 
   HwmpProtocol& operator= (const HwmpProtocol &);
   HwmpProtocol (const HwmpProtocol &);
@@ -109,6 +117,7 @@ private:
     uint16_t protocol; ///< protocol number
     uint32_t inInterface; ///< incoming device interface ID. (if packet has come from upper layers, this is Mesh point ID)
     RouteReplyCallback reply; ///< how to reply
+    uint32_t arrival; ///< arrival number, orders the packets of different destinations
 
     QueuedPacket ();
   };
@@ -210,6 +219,9 @@ private:
     uint16_t droppedTtl;
     uint16_t totalQueued;
     uint16_t totalDropped;
+    uint16_t droppedQueueFull;
+    uint16_t maxQueued;
+    uint16_t maxQueuedDestinations;
     uint16_t initiatedPreq;
     uint16_t initiatedPrep;
     uint16_t initiatedPerr;
@@ -246,8 +258,14 @@ private:
   /// Random start in Proactive PREQ propagation
   Time m_randomStart;
   ///\}
-  /// Packet Queue
-  std::vector<QueuedPacket> m_rqueue;
+  ///\name Packet Queue
+  ///\{
+  /// Packets waiting for a route, in arrival order per destination
+  std::map<Mac48Address, std::deque<QueuedPacket> > m_rqueue;
+  /// Destination of each queued packet by its arrival number, i.e. all the packets in arrival order
+  std::map<uint32_t, Mac48Address> m_rqueueArrivals;
+  uint32_t m_nextArrival;
+  ///\}
   ///\name HWMP-protocol parameters (attributes of GetTypeId)
   ///\{
   uint16_t m_maxQueueSize;
@@ -0,0 +1,98 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Time the HwmpRtable of one mesh point of a --nodes mesh, which has a
+ * reactive route to each other mesh point through one of its --neighbours:
+ * building the table, looking up a route for each forwarded frame, and
+ * finding the destinations to report in a PERR when a link to a
+ * neighbour breaks.
+ */
+
+#include "hwmp-rtable.h"
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::dot11s;
+
+int main (int argc, char *argv[])
+{
+  uint32_t nNodes = 400;
+  uint32_t nNeighbours = 8;
+  uint32_t nLookups = 10000000;
+  uint32_t nBuilds = 1000;
+
+  CommandLine cmd;
+  cmd.AddValue ("nodes", "The number of mesh points", nNodes);
+  cmd.AddValue ("neighbours", "The number of neighbours of the mesh point", nNeighbours);
+  cmd.AddValue ("lookups", "The number of route lookups", nLookups);
+  cmd.AddValue ("builds", "The number of times the table is built and each link breaks", nBuilds);
+  cmd.Parse (argc, argv);
+
+  std::vector<Mac48Address> destinations;
+  for (uint32_t i = 0; i < nNodes - 1; i++)
+    {
+      destinations.push_back (Mac48Address::Allocate ());
+    }
+  std::vector<Mac48Address> neighbours (destinations.begin (), destinations.begin () + nNeighbours);
+
+  SystemWallClockMs clock;
+  uint64_t buildMs = 0;
+  uint64_t perrMs = 0;
+  uint32_t nFailed = 0;
+  for (uint32_t b = 0; b < nBuilds; b++)
+    {
+      Ptr<HwmpRtable> table = CreateObject<HwmpRtable> ();
+      clock.Start ();
+      for (uint32_t i = 0; i < destinations.size (); i++)
+        {
+          table->AddReactivePath (destinations[i], neighbours[i % nNeighbours], 1, 100 + i,
+                                  Seconds (10), i, 1 + i % 10);
+        }
+      buildMs += clock.End ();
+      clock.Start ();
+      for (uint32_t n = 0; n < nNeighbours; n++)
+        {
+          nFailed += table->GetUnreachableDestinations (neighbours[n]).size ();
+        }
+      perrMs += clock.End ();
+      table->Dispose ();
+    }
+
+  Ptr<HwmpRtable> table = CreateObject<HwmpRtable> ();
+  for (uint32_t i = 0; i < destinations.size (); i++)
+    {
+      table->AddReactivePath (destinations[i], neighbours[i % nNeighbours], 1, 100 + i,
+                              Seconds (10), i, 1 + i % 10);
+    }
+  uint64_t checksum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < nLookups; i++)
+    {
+      checksum += table->LookupReactive (destinations[i % destinations.size ()]).metric;
+    }
+  uint64_t lookupMs = clock.End ();
+
+  std::cout << nNodes << " nodes, " << nNeighbours << " neighbours:" << std::endl
+            << "  build: " << (buildMs * 1e6 / nBuilds / destinations.size ()) << "ns/route" << std::endl
+            << "  lookup: " << (lookupMs * 1e6 / nLookups) << "ns/lookup (checksum=" << checksum << ")" << std::endl
+            << "  perr: " << (perrMs * 1e6 / nBuilds / nNeighbours) << "ns/broken link ("
+            << nFailed / nBuilds << " unreachable destinations per table)" << std::endl;
+  return 0;
+}
@@ -52,28 +52,49 @@ void
 HwmpRtable::DoDispose ()
 {
   m_routes.clear ();
+  m_destinationsByRetransmitter.clear ();
 }
 void
 HwmpRtable::AddReactivePath (Mac48Address destination, Mac48Address retransmitter, uint32_t interface,
-    uint32_t metric, Time lifetime, uint32_t seqnum)
+    uint32_t metric, Time lifetime, uint32_t seqnum, uint32_t hopcount)
 {
-  std::map<Mac48Address, ReactiveRoute>::iterator i = m_routes.find (destination);
+  ReactiveRoutes::iterator i = m_routes.find (destination);
   if (i == m_routes.end ())
     {
-      ReactiveRoute newroute;
-      m_routes[destination] = newroute;
+      i = m_routes.insert (std::make_pair (destination, ReactiveRoute ())).first;
+      IndexReactivePath (destination, retransmitter);
+    }
+  else if (i->second.retransmitter != retransmitter)
+    {
+      UnindexReactivePath (destination, i->second.retransmitter);
+      IndexReactivePath (destination, retransmitter);
     }
-  i = m_routes.find (destination);
-  NS_ASSERT (i != m_routes.end ());
   i->second.retransmitter = retransmitter;
   i->second.interface = interface;
   i->second.metric = metric;
   i->second.whenExpire = Simulator::Now () + lifetime;
   i->second.seqnum = seqnum;
+  i->second.hopcount = hopcount;
+}
+void
+HwmpRtable::IndexReactivePath (Mac48Address destination, Mac48Address retransmitter)
+{
+  m_destinationsByRetransmitter[retransmitter].insert (destination);
+}
+void
+HwmpRtable::UnindexReactivePath (Mac48Address destination, Mac48Address retransmitter)
+{
+  RetransmitterIndex::iterator i = m_destinationsByRetransmitter.find (retransmitter);
+  NS_ASSERT (i != m_destinationsByRetransmitter.end ());
+  i->second.erase (destination);
+  if (i->second.empty ())
+    {
+      m_destinationsByRetransmitter.erase (i);
+    }
 }
 void
 HwmpRtable::AddProactivePath (uint32_t metric, Mac48Address root, Mac48Address retransmitter,
-    uint32_t interface, Time lifetime, uint32_t seqnum)
+    uint32_t interface, Time lifetime, uint32_t seqnum, uint32_t hopcount)
 {
   m_root.root = root;
   m_root.retransmitter = retransmitter;
@@ -81,6 +102,7 @@ HwmpRtable::AddProactivePath (uint32_t metric, Mac48Address root, Mac48Address r
   m_root.whenExpire = Simulator::Now () + lifetime;
   m_root.seqnum = seqnum;
   m_root.interface = interface;
+  m_root.hopcount = hopcount;
 }
 void
 HwmpRtable::AddPrecursor (Mac48Address destination, uint32_t precursorInterface,
@@ -90,7 +112,7 @@ HwmpRtable::AddPrecursor (Mac48Address destination, uint32_t precursorInterface,
   precursor.interface = precursorInterface;
   precursor.address = precursorAddress;
   precursor.whenExpire = Simulator::Now () + lifetime;
-  std::map<Mac48Address, ReactiveRoute>::iterator i = m_routes.find (destination);
+  ReactiveRoutes::iterator i = m_routes.find (destination);
   if (i != m_routes.end ())
     {
       bool should_add = true;
@@ -119,6 +141,7 @@ HwmpRtable::DeleteProactivePath ()
   m_root.metric = MAX_METRIC;
   m_root.retransmitter = Mac48Address::GetBroadcast ();
   m_root.seqnum = 0;
+  m_root.hopcount = 0;
   m_root.whenExpire = Simulator::Now ();
 }
 void
@@ -132,16 +155,17 @@ HwmpRtable::DeleteProactivePath (Mac48Address root)
 void
 HwmpRtable::DeleteReactivePath (Mac48Address destination)
 {
-  std::map<Mac48Address, ReactiveRoute>::iterator i = m_routes.find (destination);
+  ReactiveRoutes::iterator i = m_routes.find (destination);
   if (i != m_routes.end ())
     {
+      UnindexReactivePath (destination, i->second.retransmitter);
       m_routes.erase (i);
     }
 }
 HwmpRtable::LookupResult
 HwmpRtable::LookupReactive (Mac48Address destination)
 {
-  std::map<Mac48Address, ReactiveRoute>::iterator i = m_routes.find (destination);
+  ReactiveRoutes::const_iterator i = m_routes.find (destination);
   if (i == m_routes.end ())
     {
       return LookupResult ();
@@ -151,18 +175,19 @@ HwmpRtable::LookupReactive (Mac48Address destination)
       NS_LOG_DEBUG ("Reactive route has expired, sorry.");
       return LookupResult ();
     }
-  return LookupReactiveExpired (destination);
+  return LookupResult (i->second.retransmitter, i->second.interface, i->second.metric, i->second.seqnum,
+      i->second.whenExpire - Simulator::Now (), i->second.hopcount);
 }
 HwmpRtable::LookupResult
 HwmpRtable::LookupReactiveExpired (Mac48Address destination)
 {
-  std::map<Mac48Address, ReactiveRoute>::iterator i = m_routes.find (destination);
+  ReactiveRoutes::const_iterator i = m_routes.find (destination);
   if (i == m_routes.end ())
     {
       return LookupResult ();
     }
   return LookupResult (i->second.retransmitter, i->second.interface, i->second.metric, i->second.seqnum,
-      i->second.whenExpire - Simulator::Now ());
+      i->second.whenExpire - Simulator::Now (), i->second.hopcount);
 }
 HwmpRtable::LookupResult
 HwmpRtable::LookupProactive ()
@@ -178,23 +203,28 @@ HwmpRtable::LookupResult
 HwmpRtable::LookupProactiveExpired ()
 {
   return LookupResult (m_root.retransmitter, m_root.interface, m_root.metric, m_root.seqnum,
-      m_root.whenExpire - Simulator::Now ());
+      m_root.whenExpire - Simulator::Now (), m_root.hopcount);
 }
 std::vector<HwmpProtocol::FailedDestination>
 HwmpRtable::GetUnreachableDestinations (Mac48Address peerAddress)
 {
   HwmpProtocol::FailedDestination dst;
   std::vector<HwmpProtocol::FailedDestination> retval;
-  for (std::map<Mac48Address, ReactiveRoute>::iterator i = m_routes.begin (); i != m_routes.end (); i++)
-  {
-      if (i->second.retransmitter == peerAddress)
+  RetransmitterIndex::const_iterator destinations = m_destinationsByRetransmitter.find (peerAddress);
+  if (destinations != m_destinationsByRetransmitter.end ())
+    {
+      // the destinations are sorted, as they were when all the routes were scanned
+      for (std::set<Mac48Address>::const_iterator i = destinations->second.begin ();
+          i != destinations->second.end (); i++)
         {
-          dst.destination = i->first;
-          i->second.seqnum++;
-          dst.seqnum = i->second.seqnum;
+          ReactiveRoutes::iterator route = m_routes.find (*i);
+          NS_ASSERT (route != m_routes.end ());
+          dst.destination = *i;
+          route->second.seqnum++;
+          dst.seqnum = route->second.seqnum;
           retval.push_back (dst);
         }
-  }
+    }
   //Lookup a path to root
   if (m_root.retransmitter == peerAddress)
     {
@@ -209,7 +239,7 @@ HwmpRtable::GetPrecursors (Mac48Address destination)
 {
   //We suppose that no duplicates here can be
   PrecursorList retval;
-  std::map<Mac48Address, ReactiveRoute>::iterator route = m_routes.find (destination);
+  ReactiveRoutes::const_iterator route = m_routes.find (destination);
   if (route != m_routes.end ())
     {
       for (std::vector<Precursor>::const_iterator i = route->second.precursors.begin ();
@@ -229,8 +259,8 @@ HwmpRtable::LookupResult::operator== (const HwmpRtable::LookupResult & o) const
   return (retransmitter == o.retransmitter && ifIndex == o.ifIndex && metric == o.metric && seqnum
       == o.seqnum);
 }
-HwmpRtable::LookupResult::LookupResult (Mac48Address r, uint32_t i, uint32_t m, uint32_t s, Time l) :
-  retransmitter (r), ifIndex (i), metric (m), seqnum (s), lifetime (l)
+HwmpRtable::LookupResult::LookupResult (Mac48Address r, uint32_t i, uint32_t m, uint32_t s, Time l, uint32_t h) :
+  retransmitter (r), ifIndex (i), metric (m), seqnum (s), lifetime (l), hopcount (h)
 {
 }
 bool
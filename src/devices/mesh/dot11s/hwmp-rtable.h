@@ -21,7 +21,8 @@
 #ifndef HWMP_RTABLE_H
 #define HWMP_RTABLE_H
 
-#include <map>
+#include <set>
+#include <tr1/unordered_map>
 #include "ns3/nstime.h"
 #include "ns3/mac48-address.h"
 #include "ns3/hwmp-protocol.h"
@@ -48,11 +49,14 @@ public:
     uint32_t metric;
     uint32_t seqnum;
     Time lifetime;
+    /// the number of hops to the destination, 0 if it is not known
+    uint32_t hopcount;
     LookupResult (Mac48Address r = Mac48Address::GetBroadcast (),
                  uint32_t i = INTERFACE_ANY,
                  uint32_t m = MAX_METRIC,
                  uint32_t s = 0,
-                 Time l = Seconds (0.0));
+                 Time l = Seconds (0.0),
+                 uint32_t h = 0);
     /// True for valid route
     bool IsValid () const;
     /// Compare route lookup results, used by tests
@@ -75,7 +79,8 @@ public:
     uint32_t interface,
     uint32_t metric,
     Time  lifetime,
-    uint32_t seqnum
+    uint32_t seqnum,
+    uint32_t hopcount = 0
   );
   void AddProactivePath (
     uint32_t metric,
@@ -83,7 +88,8 @@ public:
     Mac48Address retransmitter,
     uint32_t interface,
     Time  lifetime,
-    uint32_t seqnum
+    uint32_t seqnum,
+    uint32_t hopcount = 0
   );
   void AddPrecursor (Mac48Address destination, uint32_t precursorInterface, Mac48Address precursorAddress, Time lifetime);
   PrecursorList GetPrecursors (Mac48Address destination);
@@ -122,6 +128,7 @@ private:
     uint32_t metric;
     Time whenExpire;
     uint32_t seqnum;
+    uint32_t hopcount;
     std::vector<Precursor> precursors;
   };
   /// Route fond in proactive mode
@@ -133,11 +140,20 @@ private:
     uint32_t metric;
     Time whenExpire;
     uint32_t seqnum;
+    uint32_t hopcount;
     std::vector<Precursor> precursors;
   };
 
+  typedef std::tr1::unordered_map<Mac48Address, ReactiveRoute, Mac48AddressHash> ReactiveRoutes;
+  /// The destinations of the reactive routes through each retransmitter
+  typedef std::tr1::unordered_map<Mac48Address, std::set<Mac48Address>, Mac48AddressHash> RetransmitterIndex;
+
+  void IndexReactivePath (Mac48Address destination, Mac48Address retransmitter);
+  void UnindexReactivePath (Mac48Address destination, Mac48Address retransmitter);
+
   /// List of routes
-  std::map<Mac48Address, ReactiveRoute>  m_routes;
+  ReactiveRoutes m_routes;
+  RetransmitterIndex m_destinationsByRetransmitter;
   /// Path to proactive tree root MP
   ProactiveRoute  m_root;
 };
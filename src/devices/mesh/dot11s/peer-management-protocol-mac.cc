@@ -62,26 +62,32 @@ PeerManagementProtocolMac::TxOk (WifiMacHeader const &hdr)
 bool
 PeerManagementProtocolMac::Receive (Ptr<Packet> const_packet, const WifiMacHeader & header)
 {
-  // First of all we copy a packet, because we need to remove some
-  //headers
-  Ptr<Packet> packet = const_packet->Copy ();
   if (header.IsBeacon ())
     {
-      MgtBeaconHeader beacon_hdr;
-      packet->RemoveHeader (beacon_hdr);
-      MeshInformationElementVector elements;
-      packet->RemoveHeader(elements);
-      Ptr<IeBeaconTiming> beaconTiming = DynamicCast<IeBeaconTiming> (elements.FindFirst (IE11S_BEACON_TIMING));
-      Ptr<IeMeshId> meshId = DynamicCast<IeMeshId> (elements.FindFirst (IE11S_MESH_ID));
+      // Only the mesh ID and beacon timing elements are needed, so peek
+      // them without copying the packet
+      Ptr<IeBeaconTiming> beaconTiming = Create<IeBeaconTiming> ();
+      Ptr<IeMeshId> meshId = Create<IeMeshId> ();
+      MeshWifiBeaconView beacon;
+      beacon.Select (beaconTiming);
+      beacon.Select (meshId);
+      const_packet->PeekHeader (beacon);
+      if (!beacon.IsPresent (IE11S_BEACON_TIMING))
+        {
+          beaconTiming = 0;
+        }
 
-      if ((meshId != 0) && (m_protocol->GetMeshId ()->IsEqual (*meshId)))
+      if (beacon.IsPresent (IE11S_MESH_ID) && (m_protocol->GetMeshId ()->IsEqual (*meshId)))
         {
           m_protocol->ReceiveBeacon (m_ifIndex, header.GetAddr2 (), MicroSeconds (
-              beacon_hdr.GetBeaconIntervalUs ()), beaconTiming);
+              beacon.BeaconHeader ().GetBeaconIntervalUs ()), beaconTiming);
         }
       // Beacon shall not be dropped. May be needed to another plugins
       return true;
     }
+  // First of all we copy a packet, because we need to remove some
+  //headers
+  Ptr<Packet> packet = const_packet->Copy ();
   if (header.IsAction ())
     {
       WifiActionHeader actionHdr;
@@ -104,6 +104,7 @@ PeerManagementProtocol::DoDispose ()
       j->second.clear ();
     }
   m_peerLinks.clear ();
+  m_beaconTimingElements.clear ();
   m_plugins.clear ();
 }
 
@@ -142,6 +143,11 @@ PeerManagementProtocol::GetBeaconTimingElement (uint32_t interface)
     {
       return 0;
     }
+  Ptr<IeBeaconTiming> & cached = m_beaconTimingElements[interface];
+  if (cached != 0)
+    {
+      return cached;
+    }
   Ptr<IeBeaconTiming> retval = Create<IeBeaconTiming> ();
   PeerLinksMap::iterator iface = m_peerLinks.find (interface);
   NS_ASSERT (iface != m_peerLinks.end ());
@@ -157,6 +163,7 @@ PeerManagementProtocol::GetBeaconTimingElement (uint32_t interface)
       retval->AddNeighboursTimingElementUnit ((*i)->GetLocalAid (), (*i)->GetLastBeacon (),
           (*i)->GetBeaconInterval ());
     }
+  cached = retval;
   return retval;
 }
 void
@@ -182,6 +189,8 @@ PeerManagementProtocol::ReceiveBeacon (uint32_t interface, Mac48Address peerAddr
         }
     }
   peerLink->SetBeaconInformation (Simulator::Now (), beaconInterval);
+  // the timing of this neighbour changed
+  m_beaconTimingElements.erase (interface);
   if (GetBeaconCollisionAvoidance ())
     {
       peerLink->SetBeaconTimingElement (*PeekPointer (timingElement));
@@ -295,6 +304,7 @@ PeerManagementProtocol::FindPeerLink (uint32_t interface, Mac48Address peerAddre
             {
               (*i) = 0;
               (iface->second).erase (i);
+              m_beaconTimingElements.erase (interface);
               return 0;
             }
           else
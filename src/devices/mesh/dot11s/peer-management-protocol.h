@@ -72,6 +72,10 @@ public:
    * element
    * \return IeBeaconTiming is a beacon timing element that should be present in beacon
    * \param interface is a interface sending a beacon
+   *
+   * The element is kept and returned again until the timing of a neighbour
+   * on this interface changes, so that the beacon template does not
+   * serialize it again.
    */
   Ptr<IeBeaconTiming> GetBeaconTimingElement (uint32_t interface);
   /**
@@ -231,6 +235,8 @@ private:
   /**
    * \}
    */
+  ///Beacon timing element of each interface, rebuilt when it is missing
+  std::map<uint32_t, Ptr<IeBeaconTiming> > m_beaconTimingElements;
   /**
    * \brief Callback to notify about peer link changes:
    * Mac48Address is peer address of mesh point,
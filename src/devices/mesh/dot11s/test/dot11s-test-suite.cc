@@ -23,8 +23,15 @@
 #include "ns3/mgt-headers.h"
 #include "../dot11s-mac-header.h"
 #include "../hwmp-rtable.h"
+#include "../hwmp-protocol.h"
 #include "../peer-link-frame.h"
 #include "../ie-dot11s-peer-management.h"
+#include "../ie-dot11s-beacon-timing.h"
+#include "../ie-dot11s-id.h"
+#include "ns3/mesh-wifi-beacon.h"
+#include "ns3/uinteger.h"
+#include <vector>
+#include <cstring>
 
 namespace ns3 {
 namespace dot11s {
@@ -94,6 +101,8 @@ public:
 private:
   /// Test Add apth and lookup path;
   void TestLookup ();
+  /// Test the destinations which become unreachable when a link breaks
+  void TestUnreachable ();
   /**
    * \name Test add path and try to lookup after entry has expired
    * \{
@@ -141,16 +150,53 @@ HwmpRtableTest::TestLookup ()
   // Reactive path
   table->AddReactivePath (dst, hop, iface, metric, expire, seqnum);
   NS_TEST_EXPECT_MSG_EQ ((table->LookupReactive (dst) == correct), true, "Reactive lookup works");
+  NS_TEST_EXPECT_MSG_EQ (table->LookupReactive (dst).hopcount, 0, "Unknown hop count is 0");
+  table->AddReactivePath (dst, hop, iface, metric, expire, seqnum, 3);
+  NS_TEST_EXPECT_MSG_EQ (table->LookupReactive (dst).hopcount, 3, "Reactive hop count works");
   table->DeleteReactivePath (dst);
   NS_TEST_EXPECT_MSG_EQ (table->LookupReactive (dst).IsValid (), false, "Reactive lookup works");
 
   // Proactive
-  table->AddProactivePath (metric, dst, hop, iface, expire, seqnum);
+  table->AddProactivePath (metric, dst, hop, iface, expire, seqnum, 2);
   NS_TEST_EXPECT_MSG_EQ ((table->LookupProactive () == correct), true, "Proactive lookup works");
+  NS_TEST_EXPECT_MSG_EQ (table->LookupProactive ().hopcount, 2, "Proactive hop count works");
   table->DeleteProactivePath (dst);
   NS_TEST_EXPECT_MSG_EQ (table->LookupProactive ().IsValid (), false, "Proactive lookup works");
 }
 
+void
+HwmpRtableTest::TestUnreachable ()
+{
+  Mac48Address d1 ("01:00:00:01:00:11");
+  Mac48Address d2 ("01:00:00:01:00:12");
+  Mac48Address d3 ("01:00:00:01:00:13");
+  Mac48Address d4 ("01:00:00:01:00:14");
+  Mac48Address hop2 ("01:00:00:01:00:04");
+  table->AddReactivePath (d4, hop2, iface, metric, expire, 40);
+  table->AddReactivePath (d3, hop, iface, metric, expire, 30);
+  table->AddReactivePath (d2, hop, iface, metric, expire, 20);
+  table->AddReactivePath (d1, hop, iface, metric, expire, 10);
+  // d2 moves to hop2 and d3 is deleted
+  table->AddReactivePath (d2, hop2, iface, metric, expire, 21);
+  table->DeleteReactivePath (d3);
+
+  std::vector<HwmpProtocol::FailedDestination> failed = table->GetUnreachableDestinations (hop);
+  NS_TEST_EXPECT_MSG_EQ (failed.size (), 1, "Unreachable destinations work");
+  NS_TEST_EXPECT_MSG_EQ (failed[0].destination, d1, "Unreachable destinations work");
+  NS_TEST_EXPECT_MSG_EQ (failed[0].seqnum, 11, "Unreachable destinations increment seqnum");
+  failed = table->GetUnreachableDestinations (hop2);
+  NS_TEST_EXPECT_MSG_EQ (failed.size (), 2, "Unreachable destinations work");
+  NS_TEST_EXPECT_MSG_EQ (failed[0].destination, d2, "Unreachable destinations are sorted");
+  NS_TEST_EXPECT_MSG_EQ (failed[0].seqnum, 22, "Unreachable destinations increment seqnum");
+  NS_TEST_EXPECT_MSG_EQ (failed[1].destination, d4, "Unreachable destinations are sorted");
+  NS_TEST_EXPECT_MSG_EQ (failed[1].seqnum, 41, "Unreachable destinations increment seqnum");
+
+  table->DeleteReactivePath (d1);
+  table->DeleteReactivePath (d2);
+  table->DeleteReactivePath (d4);
+  NS_TEST_EXPECT_MSG_EQ (table->GetUnreachableDestinations (hop2).size (), 0, "Deleted paths are unreachable");
+}
+
 void
 HwmpRtableTest::TestAddPath ()
 {
@@ -199,6 +245,7 @@ HwmpRtableTest::DoRun ()
   table = CreateObject<HwmpRtable> ();
 
   Simulator::Schedule (Seconds (0), &HwmpRtableTest::TestLookup, this);
+  Simulator::Schedule (Seconds (0.5), &HwmpRtableTest::TestUnreachable, this);
   Simulator::Schedule (Seconds (1), &HwmpRtableTest::TestAddPath, this);
   Simulator::Schedule (Seconds (2), &HwmpRtableTest::TestPrecursorAdd, this);
   Simulator::Schedule (expire + Seconds (2), &HwmpRtableTest::TestExpire, this);
@@ -274,6 +321,190 @@ PeerLinkFrameStartTest::DoRun ()
   return GetErrorStatus ();
 }
 //-----------------------------------------------------------------------------
+/// Unit test for the queue of the packets of HwmpProtocol waiting for a route
+class HwmpProtocolQueueTest : public TestCase
+{
+public:
+  HwmpProtocolQueueTest ();
+  virtual bool DoRun ();
+
+private:
+  /// Queue a packet of the given size to the given destination
+  bool Queue (Mac48Address dst, uint32_t size);
+  /// Check that the queue holds the given number of packets and destinations
+  void CheckQueued (uint32_t packets, uint32_t destinations, std::string msg);
+  /// Records the replies of the protocol
+  void Reply (bool success, Ptr<Packet> packet, Mac48Address src, Mac48Address dst, uint16_t protocol, uint32_t iface);
+
+  Ptr<HwmpProtocol> hwmp;
+  /// Sizes of the packets replied, which identify them
+  std::vector<uint32_t> sent;
+  std::vector<uint32_t> dropped;
+};
+
+HwmpProtocolQueueTest::HwmpProtocolQueueTest () :
+  TestCase ("HWMP queue of the packets waiting for a route")
+{
+}
+
+bool
+HwmpProtocolQueueTest::Queue (Mac48Address dst, uint32_t size)
+{
+  HwmpProtocol::QueuedPacket packet;
+  packet.pkt = Create<Packet> (size);
+  packet.dst = dst;
+  packet.reply = MakeCallback (&HwmpProtocolQueueTest::Reply, this);
+  return hwmp->QueuePacket (packet);
+}
+
+void
+HwmpProtocolQueueTest::CheckQueued (uint32_t packets, uint32_t destinations, std::string msg)
+{
+  NS_TEST_EXPECT_MSG_EQ (hwmp->m_rqueueArrivals.size (), packets, msg);
+  NS_TEST_EXPECT_MSG_EQ (hwmp->m_rqueue.size (), destinations, msg);
+}
+
+void
+HwmpProtocolQueueTest::Reply (bool success, Ptr<Packet> packet, Mac48Address src, Mac48Address dst,
+                              uint16_t protocol, uint32_t iface)
+{
+  if (success)
+    {
+      sent.push_back (packet->GetSize ());
+    }
+  else
+    {
+      dropped.push_back (packet->GetSize ());
+    }
+}
+
+bool
+HwmpProtocolQueueTest::DoRun ()
+{
+  Mac48Address d1 ("00:00:00:00:00:01");
+  Mac48Address d2 ("00:00:00:00:00:02");
+  Mac48Address d3 ("00:00:00:00:00:03");
+  hwmp = CreateObject<HwmpProtocol> ();
+  hwmp->SetAttribute ("MaxQueueSize", UintegerValue (4));
+
+  // The queue is full with 4 packets, after which packets are dropped
+  NS_TEST_EXPECT_MSG_EQ (Queue (d1, 1), true, "Packet is queued");
+  NS_TEST_EXPECT_MSG_EQ (Queue (d2, 2), true, "Packet is queued");
+  NS_TEST_EXPECT_MSG_EQ (Queue (d1, 3), true, "Packet is queued");
+  NS_TEST_EXPECT_MSG_EQ (Queue (d2, 4), true, "Packet is queued");
+  NS_TEST_EXPECT_MSG_EQ (Queue (d3, 5), false, "Packet is dropped when the queue is full");
+  CheckQueued (4, 2, "Queue is full");
+  NS_TEST_EXPECT_MSG_EQ (hwmp->m_stats.droppedQueueFull, 1, "Drops are counted");
+  NS_TEST_EXPECT_MSG_EQ (hwmp->m_stats.maxQueued, 4, "Peak queue length is counted");
+  NS_TEST_EXPECT_MSG_EQ (hwmp->m_stats.maxQueuedDestinations, 2, "Peak number of destinations is counted");
+
+  // FIFO order within a destination
+  NS_TEST_EXPECT_MSG_EQ (hwmp->DequeueFirstPacketByDst (d1).pkt->GetSize (), 1, "Packets of a destination are FIFO");
+  NS_TEST_EXPECT_MSG_EQ (hwmp->DequeueFirstPacketByDst (d1).pkt->GetSize (), 3, "Packets of a destination are FIFO");
+  NS_TEST_EXPECT_MSG_EQ (hwmp->DequeueFirstPacketByDst (d1).pkt, 0, "Destination has no more packets");
+  CheckQueued (2, 1, "Dequeued packets are removed");
+
+  // Global arrival order across destinations
+  NS_TEST_EXPECT_MSG_EQ (Queue (d3, 6), true, "Packet is queued");
+  NS_TEST_EXPECT_MSG_EQ (Queue (d2, 7), true, "Packet is queued");
+  NS_TEST_EXPECT_MSG_EQ (hwmp->DequeueFirstPacket ().pkt->GetSize (), 2, "Packets leave in arrival order");
+  NS_TEST_EXPECT_MSG_EQ (hwmp->DequeueFirstPacket ().pkt->GetSize (), 4, "Packets leave in arrival order");
+  NS_TEST_EXPECT_MSG_EQ (hwmp->DequeueFirstPacket ().pkt->GetSize (), 6, "Packets leave in arrival order");
+  NS_TEST_EXPECT_MSG_EQ (hwmp->DequeueFirstPacket ().pkt->GetSize (), 7, "Packets leave in arrival order");
+  NS_TEST_EXPECT_MSG_EQ (hwmp->DequeueFirstPacket ().pkt, 0, "Queue is empty");
+  CheckQueued (0, 0, "Queue is empty");
+
+  // The packets of a destination are sent when its route resolves
+  Queue (d1, 8);
+  Queue (d2, 9);
+  Queue (d1, 10);
+  hwmp->m_rtable->AddReactivePath (d1, d3, 1, 1, Seconds (10), 1, 1);
+  hwmp->ReactivePathResolved (d1);
+  NS_TEST_EXPECT_MSG_EQ (sent.size (), 2, "Packets are sent when the route resolves");
+  NS_TEST_EXPECT_MSG_EQ (sent[0], 8, "Packets are sent in order");
+  NS_TEST_EXPECT_MSG_EQ (sent[1], 10, "Packets are sent in order");
+  CheckQueued (1, 1, "Sent packets are removed");
+
+  // and are dropped when the discovery of its route times out
+  hwmp->ShouldSendPreq (d2);
+  hwmp->RetryPathDiscovery (d2, hwmp->m_dot11MeshHWMPmaxPREQretries + 1);
+  NS_TEST_EXPECT_MSG_EQ (dropped.size (), 1, "Packets are dropped when the route discovery times out");
+  NS_TEST_EXPECT_MSG_EQ (dropped[0], 9, "Packets are dropped when the route discovery times out");
+  CheckQueued (0, 0, "Dropped packets are removed");
+
+  hwmp->Dispose ();
+  hwmp = 0;
+  Simulator::Destroy ();
+  return GetErrorStatus ();
+}
+//-----------------------------------------------------------------------------
+/// Built-in self test for MeshWifiBeaconTemplate and MeshWifiBeaconView
+struct MeshWifiBeaconTest : public TestCase
+{
+  MeshWifiBeaconTest () :
+    TestCase ("Mesh beacon template and view unit tests")
+  {
+  }
+  virtual bool DoRun ();
+private:
+  bool HaveSameBytes (Ptr<Packet> a, Ptr<Packet> b);
+};
+
+bool
+MeshWifiBeaconTest::HaveSameBytes (Ptr<Packet> a, Ptr<Packet> b)
+{
+  if (a->GetSize () != b->GetSize ())
+    {
+      return false;
+    }
+  std::vector<uint8_t> bytesA (a->GetSize ());
+  std::vector<uint8_t> bytesB (b->GetSize ());
+  a->CopyData (&bytesA[0], a->GetSize ());
+  b->CopyData (&bytesB[0], b->GetSize ());
+  return std::memcmp (&bytesA[0], &bytesB[0], bytesA.size ()) == 0;
+}
+
+bool
+MeshWifiBeaconTest::DoRun ()
+{
+  MeshWifiBeaconTemplate beaconTemplate;
+  Ptr<IeMeshId> meshId = Create<IeMeshId> ("qwerty");
+  Ptr<IeBeaconTiming> timing = Create<IeBeaconTiming> ();
+  timing->AddNeighboursTimingElementUnit (1, Seconds (1), Seconds (0.1));
+  {
+    MeshWifiBeacon beacon (Ssid ("mesh"), SupportedRates (), 102400);
+    beacon.AddInformationElement (timing);
+    beacon.AddInformationElement (meshId);
+    NS_TEST_EXPECT_MSG_EQ (HaveSameBytes (beacon.CreatePacket (beaconTemplate), beacon.CreatePacket ()), true,
+        "Beacon template serializes the elements");
+    NS_TEST_EXPECT_MSG_EQ (beaconTemplate.GetSerializedElements (), 2, "Beacon template serializes new elements");
+  }
+  // The next beacon has new timing and the same mesh ID
+  timing = Create<IeBeaconTiming> ();
+  timing->AddNeighboursTimingElementUnit (2, Seconds (2), Seconds (0.1));
+  MeshWifiBeacon beacon (Ssid ("mesh"), SupportedRates (), 102400);
+  beacon.AddInformationElement (timing);
+  beacon.AddInformationElement (meshId);
+  Ptr<Packet> packet = beacon.CreatePacket (beaconTemplate);
+  NS_TEST_EXPECT_MSG_EQ (HaveSameBytes (packet, beacon.CreatePacket ()), true,
+      "Beacon template serializes the changed elements");
+  NS_TEST_EXPECT_MSG_EQ (beaconTemplate.GetSerializedElements (), 3, "Beacon template reuses the same elements");
+
+  Ptr<IeMeshId> receivedMeshId = Create<IeMeshId> ();
+  Ptr<IeBeaconTiming> receivedTiming = Create<IeBeaconTiming> ();
+  MeshWifiBeaconView view;
+  view.Select (receivedMeshId);
+  view.Select (receivedTiming);
+  packet->PeekHeader (view);
+  NS_TEST_EXPECT_MSG_EQ (view.IsPresent (IE11S_MESH_ID), true, "Beacon view finds the mesh ID");
+  NS_TEST_EXPECT_MSG_EQ (receivedMeshId->IsEqual (*meshId), true, "Beacon view reads the mesh ID");
+  NS_TEST_EXPECT_MSG_EQ (view.IsPresent (IE11S_BEACON_TIMING), true, "Beacon view finds the beacon timing");
+  NS_TEST_EXPECT_MSG_EQ ((*receivedTiming == *timing), true, "Beacon view reads the beacon timing");
+  NS_TEST_EXPECT_MSG_EQ (view.BeaconHeader ().GetBeaconIntervalUs (), 102400, "Beacon view reads the beacon header");
+  NS_TEST_EXPECT_MSG_EQ (view.IsPresent (IE11S_PEERING_MANAGEMENT), false, "Beacon view reports missing elements");
+  return GetErrorStatus ();
+}
+//-----------------------------------------------------------------------------
 class Dot11sTestSuite : public TestSuite
 {
 public:
@@ -285,7 +516,9 @@ Dot11sTestSuite::Dot11sTestSuite ()
 {
   AddTestCase (new MeshHeaderTest);
   AddTestCase (new HwmpRtableTest);
+  AddTestCase (new HwmpProtocolQueueTest);
   AddTestCase (new PeerLinkFrameStartTest);
+  AddTestCase (new MeshWifiBeaconTest);
 }
 
 Dot11sTestSuite g_dot11sTestSuite;
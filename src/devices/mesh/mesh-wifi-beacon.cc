@@ -19,6 +19,7 @@
  */
 
 #include "ns3/mesh-wifi-beacon.h"
+#include "ns3/fatal-error.h"
 
 
 namespace ns3 {
@@ -49,6 +50,14 @@ MeshWifiBeacon::CreatePacket ()
   packet->AddHeader (BeaconHeader ());
   return packet;
 }
+Ptr<Packet>
+MeshWifiBeacon::CreatePacket (MeshWifiBeaconTemplate & beaconTemplate)
+{
+  beaconTemplate.Update (m_elements.Begin (), m_elements.End ());
+  Ptr<Packet> packet = beaconTemplate.CreatePacket ();
+  packet->AddHeader (BeaconHeader ());
+  return packet;
+}
 WifiMacHeader
 MeshWifiBeacon::CreateHeader (Mac48Address address, Mac48Address mpAddress)
 {
@@ -63,5 +72,154 @@ MeshWifiBeacon::CreateHeader (Mac48Address address, Mac48Address mpAddress)
 
   return hdr;
 }
+
+MeshWifiBeaconTemplate::MeshWifiBeaconTemplate () :
+  m_serializedElements (0)
+{
+}
+void
+MeshWifiBeaconTemplate::Update (WifiInformationElementVector::Iterator begin,
+                                WifiInformationElementVector::Iterator end)
+{
+  bool changed = false;
+  uint32_t n = 0;
+  for (WifiInformationElementVector::Iterator i = begin; i != end; i++, n++)
+    {
+      if ((n < m_elements.size ()) && (m_elements[n].ie == *i))
+        {
+          continue;
+        }
+      changed = true;
+      if (n == m_elements.size ())
+        {
+          m_elements.push_back (Element ());
+        }
+      Buffer buffer;
+      buffer.AddAtStart ((*i)->GetSerializedSize ());
+      (*i)->Serialize (buffer.Begin ());
+      m_elements[n].ie = *i;
+      m_elements[n].bytes.resize (buffer.GetSize ());
+      buffer.CopyData (&m_elements[n].bytes[0], buffer.GetSize ());
+      m_serializedElements++;
+    }
+  if (n != m_elements.size ())
+    {
+      m_elements.resize (n);
+      changed = true;
+    }
+  if (changed)
+    {
+      m_bytes.clear ();
+      for (std::vector<Element>::const_iterator i = m_elements.begin (); i != m_elements.end (); i++)
+        {
+          m_bytes.insert (m_bytes.end (), i->bytes.begin (), i->bytes.end ());
+        }
+    }
+}
+Ptr<Packet>
+MeshWifiBeaconTemplate::CreatePacket () const
+{
+  if (m_bytes.empty ())
+    {
+      return Create<Packet> ();
+    }
+  return Create<Packet> (&m_bytes[0], m_bytes.size ());
+}
+uint32_t
+MeshWifiBeaconTemplate::GetSerializedElements () const
+{
+  return m_serializedElements;
+}
+void
+MeshWifiBeaconTemplate::Clear ()
+{
+  m_elements.clear ();
+  m_bytes.clear ();
+}
+
+NS_OBJECT_ENSURE_REGISTERED (MeshWifiBeaconView);
+
+MeshWifiBeaconView::MeshWifiBeaconView () :
+  m_size (0)
+{
+}
+void
+MeshWifiBeaconView::Select (Ptr<WifiInformationElement> ie)
+{
+  Selected selected;
+  selected.ie = ie;
+  selected.present = false;
+  m_selected.push_back (selected);
+}
+bool
+MeshWifiBeaconView::IsPresent (WifiInformationElementId id) const
+{
+  for (std::vector<Selected>::const_iterator i = m_selected.begin (); i != m_selected.end (); i++)
+    {
+      if (i->present && (i->ie->ElementId () == id))
+        {
+          return true;
+        }
+    }
+  return false;
+}
+TypeId
+MeshWifiBeaconView::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::MeshWifiBeaconView")
+                      .SetParent<Header> ()
+                      .AddConstructor<MeshWifiBeaconView> ();
+  return tid;
+}
+TypeId
+MeshWifiBeaconView::GetInstanceTypeId () const
+{
+  return GetTypeId ();
+}
+uint32_t
+MeshWifiBeaconView::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+  i.Next (m_header.Deserialize (i));
+  uint32_t missing = m_selected.size ();
+  for (std::vector<Selected>::iterator s = m_selected.begin (); s != m_selected.end (); s++)
+    {
+      s->present = false;
+    }
+  // Stop as soon as all the selected elements are found
+  while ((missing > 0) && !i.IsEnd ())
+    {
+      WifiInformationElementId id = i.ReadU8 ();
+      uint8_t length = i.ReadU8 ();
+      for (std::vector<Selected>::iterator s = m_selected.begin (); s != m_selected.end (); s++)
+        {
+          if (!s->present && (s->ie->ElementId () == id))
+            {
+              s->ie->DeserializeInformationField (i, length);
+              s->present = true;
+              missing--;
+              break;
+            }
+        }
+      i.Next (length);
+    }
+  m_size = i.GetDistanceFrom (start);
+  return m_size;
+}
+uint32_t
+MeshWifiBeaconView::GetSerializedSize () const
+{
+  return m_size;
+}
+void
+MeshWifiBeaconView::Serialize (Buffer::Iterator start) const
+{
+  NS_FATAL_ERROR ("MeshWifiBeaconView can only be deserialized, use MeshWifiBeacon to create a beacon");
+}
+void
+MeshWifiBeaconView::Print (std::ostream &os) const
+{
+  m_header.Print (os);
+}
 } // namespace ns3
 
@@ -26,9 +26,12 @@
 #include "ns3/mgt-headers.h"        // from wifi module
 #include "ns3/wifi-mac-header.h"
 #include "ns3/mesh-information-element-vector.h"
+#include <vector>
 
 namespace ns3 {
 
+class MeshWifiBeaconTemplate;
+
 /**
  * \brief Beacon is beacon header + list of arbitrary information elements
  *
@@ -62,6 +65,13 @@ public:
   Time GetBeaconInterval () const;
   /// Create frame = { beacon header + all information elements sorted by ElementId () }
   Ptr<Packet> CreatePacket ();
+  /**
+   * Create the same frame as CreatePacket (), serializing only the information
+   * elements which are not in the template already.
+   *
+   * \param beaconTemplate keeps the elements of the beacons previously sent
+   */
+  Ptr<Packet> CreatePacket (MeshWifiBeaconTemplate & beaconTemplate);
 
 private:
   /// Beacon header
@@ -70,6 +80,91 @@ private:
   WifiInformationElementVector m_elements;
 };
 
+/**
+ * \brief Serialized information elements of the last beacon sent
+ *
+ * An element is serialized again only when a plugin adds a different element
+ * object than in the previous beacon. So a plugin must create a new element
+ * whenever the content of its element changes, and may add the same element
+ * every beacon otherwise, as the peer management protocol does with its mesh
+ * ID and with its beacon timing element.
+ */
+class MeshWifiBeaconTemplate
+{
+public:
+  MeshWifiBeaconTemplate ();
+  /**
+   * Update the template with the elements of a beacon.
+   *
+   * \param begin is the first element of the beacon
+   * \param end is past the last element of the beacon
+   */
+  void Update (WifiInformationElementVector::Iterator begin, WifiInformationElementVector::Iterator end);
+  /// Create a packet holding the serialized elements
+  Ptr<Packet> CreatePacket () const;
+  /// Number of elements serialized since the template was created
+  uint32_t GetSerializedElements () const;
+  /// Clear the template, e.g. to release the elements kept
+  void Clear ();
+
+private:
+  struct Element
+  {
+    /// the element, kept so that its address is not reused by a new element
+    Ptr<WifiInformationElement> ie;
+    /// the serialized element, including the Element ID and length fields
+    std::vector<uint8_t> bytes;
+  };
+  std::vector<Element> m_elements;
+  /// All the serialized elements, in the order of the beacon
+  std::vector<uint8_t> m_bytes;
+  uint32_t m_serializedElements;
+};
+
+/**
+ * \brief Reads the beacon header and some information elements of a beacon
+ *
+ * Peek a received beacon with this header to deserialize only the elements
+ * selected, without copying the packet or creating the other elements,
+ * which are skipped.
+ */
+class MeshWifiBeaconView : public Header
+{
+public:
+  MeshWifiBeaconView ();
+  /**
+   * Deserialize the first element of the type of ie into ie.
+   *
+   * \param ie is the element to deserialize into
+   */
+  void Select (Ptr<WifiInformationElement> ie);
+  /// Read standard Wifi beacon header
+  MgtBeaconHeader BeaconHeader () const { return m_header; }
+  /// \return true if an element of the given type was found and deserialized
+  bool IsPresent (WifiInformationElementId id) const;
+
+  ///\name Inherited from Header
+  //\{
+  static TypeId GetTypeId ();
+  TypeId GetInstanceTypeId () const;
+  /// \attention Supposes that the rest of the buffer consists of information elements
+  uint32_t Deserialize (Buffer::Iterator start);
+  uint32_t GetSerializedSize () const;
+  void Serialize (Buffer::Iterator start) const;
+  void Print (std::ostream &os) const;
+  //\}
+
+private:
+  struct Selected
+  {
+    Ptr<WifiInformationElement> ie;
+    bool present;
+  };
+  MgtBeaconHeader m_header;
+  std::vector<Selected> m_selected;
+  uint32_t m_size;
+};
+
 }
 
 
@@ -28,6 +28,7 @@
 #include "ns3/mac-rx-middle.h"
 #include "ns3/mac-low.h"
 #include "ns3/dca-txop.h"
+#include "ns3/wifi-mac-queue.h"
 #include "ns3/random-variable.h"
 #include "ns3/simulator.h"
 #include "ns3/yans-wifi-phy.h"
@@ -297,6 +298,7 @@ MeshWifiInterfaceMac::DoDispose ()
   m_queues.clear ();
   m_plugins.clear ();
   m_beaconSendEvent.Cancel ();
+  m_beaconTemplate.Clear ();
   m_beaconDca = 0;
 
   WifiMac::DoDispose ();
@@ -573,7 +575,7 @@ MeshWifiInterfaceMac::SendBeacon ()
     {
       (*i)->UpdateBeacon (beacon);
     }
-  m_beaconDca->Queue (beacon.CreatePacket (), beacon.CreateHeader (GetAddress (), GetMeshPointAddress ()));
+  m_beaconDca->Queue (beacon.CreatePacket (m_beaconTemplate), beacon.CreateHeader (GetAddress (), GetMeshPointAddress ()));
 
   ScheduleNextBeacon ();
 }
@@ -655,6 +657,43 @@ MeshWifiInterfaceMac::SetLinkMetricCallback (Callback<uint32_t, Mac48Address, Pt
 {
   m_linkMetricCallback = cb;
 }
+void
+MeshWifiInterfaceMac::SetHopCountCallback (Callback<uint32_t, Mac48Address> cb)
+{
+  m_hopCountCallback = cb;
+  for (Queues::const_iterator i = m_queues.begin (); i != m_queues.end (); i++)
+    {
+      i->second->GetQueue ()->SetHopCountCallback (MakeCallback (&MeshWifiInterfaceMac::GetHopCount, this));
+    }
+}
+std::vector<Ptr<WifiMacQueueDelayPolicy> >
+MeshWifiInterfaceMac::GetDelayPolicies () const
+{
+  std::vector<Ptr<WifiMacQueueDelayPolicy> > policies;
+  for (Queues::const_iterator i = m_queues.begin (); i != m_queues.end (); i++)
+    {
+      policies.push_back (i->second->GetQueue ()->GetDelayPolicy ());
+    }
+  return policies;
+}
+void
+MeshWifiInterfaceMac::SetDelayPolicy (Ptr<WifiMacQueueDelayPolicy> policy)
+{
+  for (Queues::const_iterator i = m_queues.begin (); i != m_queues.end (); i++)
+    {
+      i->second->GetQueue ()->SetDelayPolicy (policy);
+    }
+}
+uint32_t
+MeshWifiInterfaceMac::GetHopCount (const WifiMacHeader &hdr)
+{
+  // Address 3 of the data frames is the mesh destination, see ForwardDown
+  if (m_hopCountCallback.IsNull () || !hdr.IsData ())
+    {
+      return 0;
+    }
+  return m_hopCountCallback (hdr.GetAddr3 ());
+}
 Ptr<WifiRemoteStationManager>
 MeshWifiInterfaceMac::GetStationManager ()
 {
@@ -33,6 +33,7 @@
 #include "ns3/wifi-mac.h"
 #include "ns3/mesh-wifi-interface-mac-plugin.h"
 #include "ns3/event-id.h"
+#include "ns3/wifi-mac-queue-delay-policy.h"
 #include "qos-utils.h"
 namespace ns3 {
 
@@ -152,6 +153,12 @@ public:
   ///\{
   void SetLinkMetricCallback (Callback<uint32_t, Mac48Address, Ptr<MeshWifiInterfaceMac> > cb);
   uint32_t GetLinkMetric (Mac48Address peerAddress);
+  /// Set the callback which gives the number of hops to a mesh destination to the delay policies of the queues
+  void SetHopCountCallback (Callback<uint32_t, Mac48Address> cb);
+  /// \return the delay policies of the queues of all access classes
+  std::vector<Ptr<WifiMacQueueDelayPolicy> > GetDelayPolicies () const;
+  /// Set the delay policy shared by the queues of all access classes
+  void SetDelayPolicy (Ptr<WifiMacQueueDelayPolicy> policy);
   Ptr<WifiRemoteStationManager> GetStationManager ();
   ///\}
   ///\brief Statistics:
@@ -165,6 +172,8 @@ public:
 private:
   /// Frame receive handler
   void  Receive (Ptr<Packet> packet, WifiMacHeader const *hdr);
+  /// Number of hops to the mesh destination of a frame given to the queues
+  uint32_t GetHopCount (const WifiMacHeader &hdr);
   /// Forward frame to mesh point
   virtual void ForwardUp (Ptr<Packet> packet, Mac48Address src, Mac48Address dst);
   /// Send frame. Frame is supposed to be tagged by routing information. TODO: clarify this point
@@ -230,9 +239,12 @@ private:
 
   /// "Timer" for the next beacon
   EventId m_beaconSendEvent;
+  /// Information elements of the last beacon sent
+  MeshWifiBeaconTemplate m_beaconTemplate;
   /// List of all installed plugins
   PluginList m_plugins;
   Callback<uint32_t, Mac48Address, Ptr<MeshWifiInterfaceMac> > m_linkMetricCallback;
+  Callback<uint32_t, Mac48Address> m_hopCountCallback;
   ///\name Statistics:
   ///\{
   struct Statistics
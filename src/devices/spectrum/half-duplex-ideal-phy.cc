@@ -400,7 +400,8 @@ HalfDuplexIdealPhy::EndRx ()
       if (!m_phyMacRxEndOkCallback.IsNull ())
         {
           NS_LOG_LOGIC (this << " calling m_phyMacRxEndOkCallback");
-          m_phyMacRxEndOkCallback (m_rxPacket);
+          // the packet is shared with the other receivers
+          m_phyMacRxEndOkCallback (m_rxPacket->Copy ());
         }
       else
         {
@@ -139,7 +139,7 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
         {
           Ptr<const SpectrumModel> txSpectrumModel = txInfoIterator->second.m_txSpectrumModel;
           NS_LOG_LOGIC ("Creating converters between SpectrumModelUids " << txSpectrumModel->GetUid () << " and " << rxSpectrumModelUid );
-          SpectrumConverter converter (txSpectrumModel, rxSpectrumModel);
+          Ptr<const SpectrumConverter> converter = SpectrumConverter::Get (txSpectrumModel, rxSpectrumModel);
           std::pair<SpectrumConverterMap_t::iterator, bool> ret2;
           ret2 = txInfoIterator->second.m_spectrumConverterMap.insert (std::make_pair (rxSpectrumModelUid, converter));                     
           NS_ASSERT (ret2.second);
@@ -182,7 +182,7 @@ MultiModelSpectrumChannel::FindAndEventuallyAddTxSpectrumModel (Ptr<const Spectr
             {
               NS_LOG_LOGIC ("Creating converters between SpectrumModelUids " << txSpectrumModelUid << " and " << rxSpectrumModelUid );
 
-              SpectrumConverter converter (txSpectrumModel, rxSpectrumModel);
+              Ptr<const SpectrumConverter> converter = SpectrumConverter::Get (txSpectrumModel, rxSpectrumModel);
               std::pair<SpectrumConverterMap_t::iterator, bool> ret2;
               ret2 = txInfoIterator->second.m_spectrumConverterMap.insert (std::make_pair (rxSpectrumModelUid, converter));                     
               NS_ASSERT (ret2.second);
@@ -214,6 +214,10 @@ MultiModelSpectrumChannel::StartTx (Ptr<PacketBurst> p, Ptr <SpectrumValue> orig
   TxSpectrumModelInfoMap_t::const_iterator txInfoIteratorerator = FindAndEventuallyAddTxSpectrumModel (originalTxPowerSpectrum->GetSpectrumModel ());
   NS_ASSERT (txInfoIteratorerator != m_txSpectrumModelInfoMap.end ());
 
+  // all the receivers share a single copy of the burst, which they
+  // must not modify (see SpectrumPhy::StartRx)
+  Ptr<PacketBurst> pktBurstCopy = p->Copy ();
+
   NS_LOG_LOGIC ("converter map for TX SpectrumModel with Uid " << txInfoIteratorerator->first);
   NS_LOG_LOGIC ("converter map size: " << txInfoIteratorerator->second.m_spectrumConverterMap.size ());
   NS_LOG_LOGIC ("converter map first element: " << txInfoIteratorerator->second.m_spectrumConverterMap.begin ()->first);
@@ -237,7 +241,7 @@ MultiModelSpectrumChannel::StartTx (Ptr<PacketBurst> p, Ptr <SpectrumValue> orig
           NS_LOG_LOGIC (" converting txPowerSpectrum SpectrumModelUids" << txSpectrumModelUid << " --> " << rxSpectrumModelUid);
           SpectrumConverterMap_t::const_iterator rxConverterIterator = txInfoIteratorerator->second.m_spectrumConverterMap.find (rxSpectrumModelUid);
           NS_ASSERT (rxConverterIterator != txInfoIteratorerator->second.m_spectrumConverterMap.end ());
-          convertedTxPowerSpectrum = rxConverterIterator->second.Convert (originalTxPowerSpectrum);
+          convertedTxPowerSpectrum = rxConverterIterator->second->Convert (originalTxPowerSpectrum);
         }
 
       std::list<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = rxInfoIterator->second.m_rxPhyList.begin ();
@@ -280,7 +284,6 @@ MultiModelSpectrumChannel::StartTx (Ptr<PacketBurst> p, Ptr <SpectrumValue> orig
                   delay = MicroSeconds (0);
                 }
 
-              Ptr<PacketBurst> pktBurstCopy = p->Copy ();
               Ptr<Object> netDevObj = (*rxPhyIterator)->GetDevice ();
               if (netDevObj)
                 {
@@ -33,7 +33,7 @@
 namespace ns3 {
 
 
-typedef std::map<SpectrumModelUid_t, SpectrumConverter> SpectrumConverterMap_t;
+typedef std::map<SpectrumModelUid_t, Ptr<const SpectrumConverter> > SpectrumConverterMap_t;
 
 
 class TxSpectrumModelInfo
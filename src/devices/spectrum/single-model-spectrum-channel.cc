@@ -100,6 +100,10 @@ SingleModelSpectrumChannel::StartTx (Ptr<PacketBurst> p, Ptr <SpectrumValue> txP
 
   PhyList::const_iterator rxPhyIterator = m_phyList.begin ();
 
+  // all the receivers share a single copy of the burst, which they
+  // must not modify (see SpectrumPhy::StartRx)
+  Ptr<PacketBurst> pktBurstCopy = p->Copy ();
+
   Ptr<MobilityModel> senderMobility = txPhy->GetMobility ()->GetObject<MobilityModel> ();
 
   NS_ASSERT (rxPhyIterator != m_phyList.end ());
@@ -140,7 +144,6 @@ SingleModelSpectrumChannel::StartTx (Ptr<PacketBurst> p, Ptr <SpectrumValue> txP
               delay = MicroSeconds (0);
             }
 
-          Ptr<PacketBurst> pktBurstCopy = p->Copy ();
           Ptr<Object> netDevObj = (*rxPhyIterator)->GetDevice ();
           if (netDevObj)
             {
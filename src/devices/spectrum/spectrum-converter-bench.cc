@@ -0,0 +1,67 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Time SpectrumConverter::Convert between the 300kHz-300GHz log model
+ * and the ISM 2.4GHz 1MHz model, in both directions, as
+ * MultiModelSpectrumChannel does for every receiver whose model
+ * differs from that of the sender. Each conversion is done --n times.
+ */
+
+#include "spectrum-model-ism2400MHz-res1MHz.h"
+#include "spectrum-model-300kHz-300GHz-log.h"
+#include "ns3/spectrum-converter.h"
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include <iostream>
+
+using namespace ns3;
+
+static void
+Bench (std::string name, Ptr<const SpectrumModel> from, Ptr<const SpectrumModel> to, uint32_t n)
+{
+  SystemWallClockMs clock;
+  clock.Start ();
+  Ptr<const SpectrumConverter> converter = SpectrumConverter::Get (from, to);
+  uint64_t setupMs = clock.End ();
+
+  Ptr<SpectrumValue> value = Create<SpectrumValue> (from);
+  *value = 1e-12;
+  double checksum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      checksum += Sum (*converter->Convert (value));
+    }
+  uint64_t ms = clock.End ();
+  std::cout << name << ": " << from->GetNumBands () << " -> " << to->GetNumBands ()
+            << " bands, setup=" << setupMs << "ms, "
+            << (ms * 1e6 / n) << "ns/conversion (checksum=" << checksum << ")" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 1000000;
+
+  CommandLine cmd;
+  cmd.AddValue ("n", "The number of conversions in each direction", n);
+  cmd.Parse (argc, argv);
+
+  Bench ("log -> ism", SpectrumModel300Khz300GhzLog, SpectrumModelIsm2400MhzRes1Mhz, n);
+  Bench ("ism -> log", SpectrumModelIsm2400MhzRes1Mhz, SpectrumModel300Khz300GhzLog, n);
+
+  return 0;
+}
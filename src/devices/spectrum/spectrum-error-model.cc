@@ -51,20 +51,7 @@ void
 ShannonSpectrumErrorModel::EvaluateChunk (const SpectrumValue& sinr, Time duration)
 {
   NS_LOG_FUNCTION (this << sinr << duration);
-  SpectrumValue CapacityPerHertz = Log2 (1 + sinr);
-  double capacity = 0;
-
-  Bands::const_iterator bi = CapacityPerHertz.ConstBandsBegin ();
-  Values::const_iterator vi = CapacityPerHertz.ConstValuesBegin ();
-
-  while (bi != CapacityPerHertz.ConstBandsEnd ())
-    {
-      NS_ASSERT (vi != CapacityPerHertz.ConstValuesEnd ());
-      capacity += (bi->fh - bi->fl) * (*vi);
-      ++bi;
-      ++vi;
-    }
-  NS_ASSERT (vi == CapacityPerHertz.ConstValuesEnd ());
+  double capacity = Integral (Log2 (1 + sinr));
   NS_LOG_LOGIC ("ChunkCapacity = " << capacity);
   m_deliverableBytes += static_cast<uint32_t> (capacity * duration.GetSeconds () / 8);
   NS_LOG_LOGIC ("DeliverableBytes = " << m_deliverableBytes);
@@ -112,7 +112,7 @@ SpectrumInterference::ConditionallyEvaluateChunk ()
   NS_LOG_FUNCTION (this);
   if (m_receiving && (Now () > m_lastChangeTime))
     {
-      SpectrumValue sinr = (*m_rxSignal) / ((*m_allSignals) - (*m_rxSignal) + (*m_noise));
+      SpectrumValue sinr = Sinr (*m_rxSignal, *m_allSignals, *m_noise);
       Time duration = Now () - m_lastChangeTime;
       m_errorModel->EvaluateChunk (sinr, duration);
     }
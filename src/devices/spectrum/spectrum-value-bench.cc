@@ -0,0 +1,127 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Time the SpectrumValue computations done for every received signal
+ * over the ISM 2.4GHz model with a resolution of 1MHz: each of them is
+ * computed --n times, once with the arithmetic operators, which
+ * allocate a temporary SpectrumValue per operation, and once with the
+ * equivalent fused kernel.
+ */
+
+#include "spectrum-model-ism2400MHz-res1MHz.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include <iostream>
+#include <math.h>
+
+using namespace ns3;
+
+static void
+Fill (SpectrumValue &v, double scale)
+{
+  uint32_t i = 0;
+  for (Values::iterator it = v.ValuesBegin (); it != v.ValuesEnd (); it++, i++)
+    {
+      *it = scale * (1.0 + sin (i));
+    }
+}
+
+static void
+Report (std::string name, uint32_t n, uint64_t ms, double checksum)
+{
+  std::cout << name << ": " << (ms * 1e6 / n) << "ns/op (checksum=" << checksum << ")" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 1000000;
+
+  CommandLine cmd;
+  cmd.AddValue ("n", "The number of times each computation is done", n);
+  cmd.Parse (argc, argv);
+
+  SpectrumValue rx (SpectrumModelIsm2400MhzRes1Mhz);
+  SpectrumValue allSignals (SpectrumModelIsm2400MhzRes1Mhz);
+  SpectrumValue noise (SpectrumModelIsm2400MhzRes1Mhz);
+  SpectrumValue loss (SpectrumModelIsm2400MhzRes1Mhz);
+  Fill (rx, 1e-12);
+  Fill (allSignals, 3e-12);
+  Fill (noise, 1e-16);
+  Fill (loss, 1e-3);
+  std::cout << "bands=" << SpectrumModelIsm2400MhzRes1Mhz->GetNumBands () << std::endl;
+
+  SystemWallClockMs clock;
+  double checksum;
+
+  checksum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      SpectrumValue sinr = rx / (allSignals - rx + noise);
+      checksum += Sum (sinr);
+    }
+  Report ("sinr, operators", n, clock.End (), checksum);
+
+  checksum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      SpectrumValue sinr = Sinr (rx, allSignals, noise);
+      checksum += Sum (sinr);
+    }
+  Report ("sinr, fused", n, clock.End (), checksum);
+
+  checksum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      SpectrumValue psd = rx * loss + noise;
+      checksum += Sum (psd);
+    }
+  Report ("rx * loss + noise, operators", n, clock.End (), checksum);
+
+  checksum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      SpectrumValue psd = rx;
+      psd.MultiplyAndAdd (loss, noise);
+      checksum += Sum (psd);
+    }
+  Report ("rx * loss + noise, fused", n, clock.End (), checksum);
+
+  checksum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      allSignals += rx;
+      allSignals -= rx;
+      checksum += allSignals[0];
+    }
+  Report ("in place add and subtract", n, clock.End (), checksum);
+
+  checksum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      checksum += Integral (rx);
+    }
+  Report ("integral", n, clock.End (), checksum);
+
+  return 0;
+}
@@ -160,6 +160,9 @@ UanChannel::TxPacket (Ptr<UanTransducer> src, Ptr<Packet> packet,
         }
     }
   NS_ASSERT (senderMobility != 0);
+  // all the receivers share a single copy of the packet, which they
+  // must not modify (see UanTransducer::Receive)
+  Ptr<Packet> copy = packet->Copy ();
   uint32_t j = 0;
   UanDeviceList::const_iterator i = m_devList.begin ();
   for (; i != m_devList.end (); i++)
@@ -180,7 +183,6 @@ UanChannel::TxPacket (Ptr<UanTransducer> src, Ptr<Packet> packet,
                                      << "m, delay=" << delay);
 
           uint32_t dstNodeId = i->first->GetNode ()->GetId ();
-          Ptr<Packet> copy = packet->Copy ();
           Simulator::ScheduleWithContext (dstNodeId, delay,
                                           &UanChannel::SendUp,
                                           this,
@@ -615,7 +615,8 @@ UanPhyGen::RxEndEvent (Ptr<Packet> pkt, double rxPowerDb, UanTxMode txMode)
       NotifyListenersRxGood ();
       if (!m_recOkCb.IsNull ())
         {
-          m_recOkCb (pkt, m_minRxSinrDb, txMode);
+          // the packet is shared with the other receivers
+          m_recOkCb (pkt->Copy (), m_minRxSinrDb, txMode);
         }
 
     }
@@ -625,7 +626,8 @@ UanPhyGen::RxEndEvent (Ptr<Packet> pkt, double rxPowerDb, UanTxMode txMode)
       NotifyListenersRxBad ();
       if (!m_recErrCb.IsNull ())
         {
-          m_recErrCb (pkt, m_minRxSinrDb);
+          // the packet is shared with the other receivers
+          m_recErrCb (pkt->Copy (), m_minRxSinrDb);
         }
     }
 
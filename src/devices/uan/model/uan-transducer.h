@@ -160,6 +160,10 @@ public:
    * \param rxPowerDb Signal power in dB of arriving packet
    * \param txMode Mode arriving packet is using
    * \param pdp PDP of arriving signal
+   *
+   * The same packet is delivered to all the receivers of a
+   * transmission: it must not be modified, and must be copied before
+   * it is handed over to a layer which might modify it.
    */
   virtual void Receive (Ptr<Packet> packet, double rxPowerDb, UanTxMode txMode, UanPdp pdp) = 0;
   /**
@@ -47,8 +47,6 @@ public:
   Dcf (DcaTxop *txop)
     : m_txop (txop)
   {
-    packetCount = 0;
-    iterationCount = 0;
   }
 private:
   virtual void DoNotifyAccessGranted (void) {
@@ -117,7 +115,7 @@ DcaTxop::DcaTxop ()
   NS_LOG_FUNCTION (this);
   m_transmissionListener = new DcaTxop::TransmissionListener (this);
   m_dcf = new DcaTxop::Dcf (this);
-  m_queue = CreateObject<WifiMacQueue> ();
+  m_queue = WifiMacQueue::CreateDefault ();
   m_rng = new RealRandomStream ();
   m_txMiddle = new MacTxMiddle ();
 }
@@ -187,6 +185,11 @@ DcaTxop::SetMaxQueueDelay (Time delay)
   NS_LOG_FUNCTION (this << delay);
   m_queue->SetMaxDelay (delay);
 }
+Ptr<WifiMacQueue>
+DcaTxop::GetQueue (void) const
+{
+  return m_queue;
+}
 void 
 DcaTxop::SetMinCw (uint32_t minCw)
 {
@@ -604,11 +607,4 @@ DcaTxop::Cancel (void)
    */
 }
 
-//added by Jason
-void DcaTxop::SetPhy(Ptr<WifiPhy> phy)
-{
-	m_phy = phy;	
-	m_queue->SetPhy(m_phy);
-}
-
 } // namespace ns3
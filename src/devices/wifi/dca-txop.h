@@ -106,10 +106,11 @@ public:
    * can be sent safely.
    */
   void Queue (Ptr<const Packet> packet, const WifiMacHeader &hdr);
-  
-  //added by jason
-  void SetPhy(Ptr<WifiPhy> phy);
-  
+  /**
+   * \returns the internal queue.
+   */
+  Ptr<WifiMacQueue> GetQueue (void) const;
+
 private:
   class TransmissionListener;
   class NavListener;
@@ -171,9 +172,6 @@ private:
   Ptr<const Packet> m_currentPacket;
   WifiMacHeader m_currentHdr;
   uint8_t m_fragmentNumber;
-  
-  //added by jason
-  Ptr<WifiPhy> m_phy;
 };
 
 } //namespace ns3
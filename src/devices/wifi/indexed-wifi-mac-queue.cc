@@ -0,0 +1,481 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "indexed-wifi-mac-queue.h"
+#include "qos-blocked-destinations.h"
+#include "ns3/simulator.h"
+#include "ns3/assert.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (IndexedWifiMacQueue);
+
+const uint32_t IndexedWifiMacQueue::NONE;
+
+TypeId
+IndexedWifiMacQueue::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::IndexedWifiMacQueue")
+    .SetParent<WifiMacQueue> ()
+    .AddConstructor<IndexedWifiMacQueue> ()
+    ;
+  return tid;
+}
+
+IndexedWifiMacQueue::IndexedWifiMacQueue ()
+  : m_head (NONE),
+    m_tail (NONE),
+    m_free (NONE),
+    m_size (0),
+    m_peeked (NONE)
+{}
+
+IndexedWifiMacQueue::~IndexedWifiMacQueue ()
+{
+  Flush ();
+}
+
+size_t
+IndexedWifiMacQueue::FlowKeyHash::operator () (FlowKey const &x) const
+{
+  return Mac48AddressHash () (x.first) * 17 + x.second;
+}
+
+bool
+IndexedWifiMacQueue::ExpiresLater (const struct Expiry &a, const struct Expiry &b)
+{
+  return a.tstamp > b.tstamp;
+}
+
+uint32_t
+IndexedWifiMacQueue::Insert (Ptr<const Packet> packet, const WifiMacHeader &hdr, Time tstamp, bool front)
+{
+  uint32_t slot = m_free;
+  if (slot == NONE)
+    {
+      slot = m_items.size ();
+      m_items.push_back (Item ());
+      m_items[slot].generation = 0;
+    }
+  else
+    {
+      m_free = m_items[slot].next;
+    }
+  struct Item &item = m_items[slot];
+  item.packet = packet;
+  item.hdr = hdr;
+  item.tstamp = tstamp;
+  item.prevInFlow = NONE;
+  item.nextInFlow = NONE;
+  if (front)
+    {
+      item.prev = NONE;
+      item.next = m_head;
+      m_head = slot;
+    }
+  else
+    {
+      item.prev = m_tail;
+      item.next = NONE;
+      m_tail = slot;
+    }
+  if (item.prev != NONE)
+    {
+      m_items[item.prev].next = slot;
+    }
+  if (item.next != NONE)
+    {
+      m_items[item.next].prev = slot;
+    }
+  if (m_head == NONE)
+    {
+      m_head = slot;
+    }
+  if (m_tail == NONE)
+    {
+      m_tail = slot;
+    }
+
+  if (hdr.IsQosData ())
+    {
+      // the packets are only added at both ends of the queue so the
+      // lists of the flows stay in the order of the queue.
+      FlowKey key = std::make_pair (hdr.GetAddr1 (), hdr.GetQosTid ());
+      Flows::iterator i = m_flows.find (key);
+      if (i == m_flows.end ())
+        {
+          struct Flow empty = {NONE, NONE, 0};
+          i = m_flows.insert (std::make_pair (key, empty)).first;
+        }
+      struct Flow &flow = i->second;
+      if (front)
+        {
+          item.nextInFlow = flow.head;
+          flow.head = slot;
+        }
+      else
+        {
+          item.prevInFlow = flow.tail;
+          flow.tail = slot;
+        }
+      if (item.prevInFlow != NONE)
+        {
+          m_items[item.prevInFlow].nextInFlow = slot;
+        }
+      if (item.nextInFlow != NONE)
+        {
+          m_items[item.nextInFlow].prevInFlow = slot;
+        }
+      if (flow.head == NONE)
+        {
+          flow.head = slot;
+        }
+      if (flow.tail == NONE)
+        {
+          flow.tail = slot;
+        }
+      flow.n++;
+    }
+
+  struct Expiry expiry;
+  expiry.tstamp = tstamp;
+  expiry.slot = slot;
+  expiry.generation = item.generation;
+  m_expiries.push_back (expiry);
+  std::push_heap (m_expiries.begin (), m_expiries.end (), &IndexedWifiMacQueue::ExpiresLater);
+  m_size++;
+  return slot;
+}
+
+void
+IndexedWifiMacQueue::Erase (uint32_t slot)
+{
+  struct Item &item = m_items[slot];
+  if (item.prev != NONE)
+    {
+      m_items[item.prev].next = item.next;
+    }
+  else
+    {
+      m_head = item.next;
+    }
+  if (item.next != NONE)
+    {
+      m_items[item.next].prev = item.prev;
+    }
+  else
+    {
+      m_tail = item.prev;
+    }
+
+  if (item.hdr.IsQosData ())
+    {
+      Flows::iterator i = m_flows.find (std::make_pair (item.hdr.GetAddr1 (), item.hdr.GetQosTid ()));
+      NS_ASSERT (i != m_flows.end ());
+      struct Flow &flow = i->second;
+      if (item.prevInFlow != NONE)
+        {
+          m_items[item.prevInFlow].nextInFlow = item.nextInFlow;
+        }
+      else
+        {
+          flow.head = item.nextInFlow;
+        }
+      if (item.nextInFlow != NONE)
+        {
+          m_items[item.nextInFlow].prevInFlow = item.prevInFlow;
+        }
+      else
+        {
+          flow.tail = item.prevInFlow;
+        }
+      flow.n--;
+      if (flow.n == 0)
+        {
+          // do not keep an entry for every flow ever seen.
+          m_flows.erase (i);
+        }
+    }
+
+  item.packet = 0;
+  item.generation++;
+  item.next = m_free;
+  m_free = slot;
+  m_size--;
+  if (m_peeked == slot)
+    {
+      m_peeked = NONE;
+    }
+}
+
+void
+IndexedWifiMacQueue::CompactExpiries (void)
+{
+  std::vector<struct Expiry> live;
+  live.reserve (m_size);
+  for (std::vector<struct Expiry>::const_iterator i = m_expiries.begin (); i != m_expiries.end (); i++)
+    {
+      if (m_items[i->slot].generation == i->generation)
+        {
+          live.push_back (*i);
+        }
+    }
+  std::make_heap (live.begin (), live.end (), &IndexedWifiMacQueue::ExpiresLater);
+  m_expiries.swap (live);
+}
+
+void
+IndexedWifiMacQueue::Cleanup (void)
+{
+  Time now = Simulator::Now ();
+  Time maxDelay = GetMaxDelay ();
+  while (!m_expiries.empty ())
+    {
+      struct Expiry expiry = m_expiries.front ();
+      bool queued = m_items[expiry.slot].generation == expiry.generation;
+      if (queued && expiry.tstamp + maxDelay > now)
+        {
+          break;
+        }
+      std::pop_heap (m_expiries.begin (), m_expiries.end (), &IndexedWifiMacQueue::ExpiresLater);
+      m_expiries.pop_back ();
+      if (queued)
+        {
+          Erase (expiry.slot);
+        }
+    }
+  // the entries of the packets which left the queue before expiring
+  // stay in the heap until the earlier ones are gone.
+  if (m_expiries.size () > 2 * m_size + 64)
+    {
+      CompactExpiries ();
+    }
+}
+
+void
+IndexedWifiMacQueue::DoEnqueue (Ptr<const Packet> packet, const WifiMacHeader &hdr, Time tstamp)
+{
+  Insert (packet, hdr, tstamp, false);
+}
+
+void
+IndexedWifiMacQueue::PushFront (Ptr<const Packet> packet, const WifiMacHeader &hdr)
+{
+  Cleanup ();
+  if (m_size == GetMaxSize ())
+    {
+      return;
+    }
+  Insert (packet, hdr, Simulator::Now (), true);
+}
+
+Ptr<const Packet>
+IndexedWifiMacQueue::Dequeue (WifiMacHeader *hdr)
+{
+  Cleanup ();
+  if (m_head == NONE)
+    {
+      return 0;
+    }
+  Ptr<const Packet> packet = m_items[m_head].packet;
+  *hdr = m_items[m_head].hdr;
+  Erase (m_head);
+  return packet;
+}
+
+Ptr<const Packet>
+IndexedWifiMacQueue::Peek (WifiMacHeader *hdr)
+{
+  Cleanup ();
+  if (m_head == NONE)
+    {
+      return 0;
+    }
+  m_peeked = m_head;
+  *hdr = m_items[m_head].hdr;
+  return m_items[m_head].packet;
+}
+
+uint32_t
+IndexedWifiMacQueue::Find (uint8_t tid, WifiMacHeader::AddressType type, Mac48Address addr) const
+{
+  NS_ASSERT (type <= 4);
+  if (type == WifiMacHeader::ADDR1)
+    {
+      Flows::const_iterator i = m_flows.find (std::make_pair (addr, tid));
+      return i == m_flows.end () ? NONE : i->second.head;
+    }
+  for (uint32_t slot = m_head; slot != NONE; slot = m_items[slot].next)
+    {
+      const WifiMacHeader &hdr = m_items[slot].hdr;
+      if (hdr.IsQosData () && GetAddress (type, hdr) == addr && hdr.GetQosTid () == tid)
+        {
+          return slot;
+        }
+    }
+  return NONE;
+}
+
+Ptr<const Packet>
+IndexedWifiMacQueue::DequeueByTidAndAddress (WifiMacHeader *hdr, uint8_t tid,
+                                             WifiMacHeader::AddressType type, Mac48Address dest)
+{
+  Cleanup ();
+  uint32_t slot = Find (tid, type, dest);
+  if (slot == NONE)
+    {
+      return 0;
+    }
+  Ptr<const Packet> packet = m_items[slot].packet;
+  *hdr = m_items[slot].hdr;
+  Erase (slot);
+  return packet;
+}
+
+Ptr<const Packet>
+IndexedWifiMacQueue::PeekByTidAndAddress (WifiMacHeader *hdr, uint8_t tid,
+                                          WifiMacHeader::AddressType type, Mac48Address dest)
+{
+  Cleanup ();
+  uint32_t slot = Find (tid, type, dest);
+  if (slot == NONE)
+    {
+      return 0;
+    }
+  m_peeked = slot;
+  *hdr = m_items[slot].hdr;
+  return m_items[slot].packet;
+}
+
+bool
+IndexedWifiMacQueue::Remove (Ptr<const Packet> packet)
+{
+  if (m_peeked != NONE && m_items[m_peeked].packet == packet)
+    {
+      Erase (m_peeked);
+      return true;
+    }
+  for (uint32_t slot = m_head; slot != NONE; slot = m_items[slot].next)
+    {
+      if (m_items[slot].packet == packet)
+        {
+          Erase (slot);
+          return true;
+        }
+    }
+  return false;
+}
+
+uint32_t
+IndexedWifiMacQueue::GetNPacketsByTidAndAddress (uint8_t tid, WifiMacHeader::AddressType type,
+                                                 Mac48Address addr)
+{
+  Cleanup ();
+  NS_ASSERT (type <= 4);
+  if (type == WifiMacHeader::ADDR1)
+    {
+      Flows::const_iterator i = m_flows.find (std::make_pair (addr, tid));
+      return i == m_flows.end () ? 0 : i->second.n;
+    }
+  uint32_t nPackets = 0;
+  for (uint32_t slot = m_head; slot != NONE; slot = m_items[slot].next)
+    {
+      const WifiMacHeader &hdr = m_items[slot].hdr;
+      if (hdr.IsQosData () && GetAddress (type, hdr) == addr && hdr.GetQosTid () == tid)
+        {
+          nPackets++;
+        }
+    }
+  return nPackets;
+}
+
+uint32_t
+IndexedWifiMacQueue::FindFirstAvailable (const QosBlockedDestinations *blockedPackets) const
+{
+  // the blocked packets are those which wait for a block ack agreement
+  // to be established, which is rarely the case of many of them.
+  for (uint32_t slot = m_head; slot != NONE; slot = m_items[slot].next)
+    {
+      const WifiMacHeader &hdr = m_items[slot].hdr;
+      if (!hdr.IsQosData () ||
+          !blockedPackets->IsBlocked (hdr.GetAddr1 (), hdr.GetQosTid ()))
+        {
+          return slot;
+        }
+    }
+  return NONE;
+}
+
+Ptr<const Packet>
+IndexedWifiMacQueue::DequeueFirstAvailable (WifiMacHeader *hdr, Time &timestamp,
+                                            const QosBlockedDestinations *blockedPackets)
+{
+  Cleanup ();
+  uint32_t slot = FindFirstAvailable (blockedPackets);
+  if (slot == NONE)
+    {
+      return 0;
+    }
+  Ptr<const Packet> packet = m_items[slot].packet;
+  *hdr = m_items[slot].hdr;
+  timestamp = m_items[slot].tstamp;
+  Erase (slot);
+  return packet;
+}
+
+Ptr<const Packet>
+IndexedWifiMacQueue::PeekFirstAvailable (WifiMacHeader *hdr, Time &timestamp,
+                                         const QosBlockedDestinations *blockedPackets)
+{
+  Cleanup ();
+  uint32_t slot = FindFirstAvailable (blockedPackets);
+  if (slot == NONE)
+    {
+      return 0;
+    }
+  m_peeked = slot;
+  *hdr = m_items[slot].hdr;
+  timestamp = m_items[slot].tstamp;
+  return m_items[slot].packet;
+}
+
+void
+IndexedWifiMacQueue::Flush (void)
+{
+  m_items.clear ();
+  m_flows.clear ();
+  m_expiries.clear ();
+  m_head = NONE;
+  m_tail = NONE;
+  m_free = NONE;
+  m_size = 0;
+  m_peeked = NONE;
+}
+
+bool
+IndexedWifiMacQueue::IsEmpty (void)
+{
+  Cleanup ();
+  return m_size == 0;
+}
+
+uint32_t
+IndexedWifiMacQueue::GetSize (void)
+{
+  return m_size;
+}
+
+} // namespace ns3
@@ -0,0 +1,138 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef INDEXED_WIFI_MAC_QUEUE_H
+#define INDEXED_WIFI_MAC_QUEUE_H
+
+#include <vector>
+#include <functional>
+#include <tr1/unordered_map>
+#include "wifi-mac-queue.h"
+
+namespace ns3 {
+
+/**
+ * \brief a WifiMacQueue which indexes its packets by destination and TID.
+ *
+ * The packets are kept in a vector of slots, which are reused through
+ * a free list, and linked in the order of the queue. The QoS data
+ * packets are also linked in one list per (address 1, TID) pair, so
+ * that the lookups of EdcaTxopN by TID and destination and the counts
+ * of packets by TID and destination take a constant time. The
+ * timestamps of the packets are kept in a heap, so that checking for
+ * expired packets takes a constant time when there is none.
+ *
+ * The lookups by address 2 or 3 search the queue linearly.
+ */
+class IndexedWifiMacQueue : public WifiMacQueue
+{
+public:
+  static TypeId GetTypeId (void);
+  IndexedWifiMacQueue ();
+  virtual ~IndexedWifiMacQueue ();
+
+  virtual void PushFront (Ptr<const Packet> packet, const WifiMacHeader &hdr);
+  virtual Ptr<const Packet> Dequeue (WifiMacHeader *hdr);
+  virtual Ptr<const Packet> Peek (WifiMacHeader *hdr);
+  virtual Ptr<const Packet> DequeueByTidAndAddress (WifiMacHeader *hdr,
+                                                    uint8_t tid,
+                                                    WifiMacHeader::AddressType type,
+                                                    Mac48Address addr);
+  virtual Ptr<const Packet> PeekByTidAndAddress (WifiMacHeader *hdr,
+                                                 uint8_t tid,
+                                                 WifiMacHeader::AddressType type,
+                                                 Mac48Address addr);
+  /**
+   * Takes a constant time when <i>packet</i> is the last one peeked,
+   * as when EdcaTxopN aggregates the packets it peeks by TID and
+   * address, and searches the queue linearly otherwise.
+   */
+  virtual bool Remove (Ptr<const Packet> packet);
+  virtual uint32_t GetNPacketsByTidAndAddress (uint8_t tid,
+                                               WifiMacHeader::AddressType type,
+                                               Mac48Address addr);
+  virtual Ptr<const Packet> DequeueFirstAvailable (WifiMacHeader *hdr,
+                                                   Time &tStamp,
+                                                   const QosBlockedDestinations *blockedPackets);
+  virtual Ptr<const Packet> PeekFirstAvailable (WifiMacHeader *hdr,
+                                                Time &tStamp,
+                                                const QosBlockedDestinations *blockedPackets);
+  virtual void Flush (void);
+  virtual bool IsEmpty (void);
+  virtual uint32_t GetSize (void);
+
+private:
+  static const uint32_t NONE = 0xffffffff;
+
+  struct Item
+  {
+    Ptr<const Packet> packet;
+    WifiMacHeader hdr;
+    Time tstamp;
+    // incremented when the slot is freed, to recognize the stale expiries.
+    uint32_t generation;
+    // the neighbours in the queue. The free slots are linked by next.
+    uint32_t prev;
+    uint32_t next;
+    // the neighbours of the same flow, for the QoS data packets.
+    uint32_t prevInFlow;
+    uint32_t nextInFlow;
+  };
+  struct Flow
+  {
+    uint32_t head;
+    uint32_t tail;
+    uint32_t n;
+  };
+  struct Expiry
+  {
+    Time tstamp;
+    uint32_t slot;
+    uint32_t generation;
+  };
+  typedef std::pair<Mac48Address, uint8_t> FlowKey;
+  class FlowKeyHash : public std::unary_function<FlowKey, size_t>
+  {
+  public:
+    size_t operator () (FlowKey const &x) const;
+  };
+  typedef std::tr1::unordered_map<FlowKey, struct Flow, FlowKeyHash> Flows;
+
+  virtual void Cleanup (void);
+  virtual void DoEnqueue (Ptr<const Packet> packet, const WifiMacHeader &hdr, Time tstamp);
+  static bool ExpiresLater (const struct Expiry &a, const struct Expiry &b);
+  uint32_t Insert (Ptr<const Packet> packet, const WifiMacHeader &hdr, Time tstamp, bool front);
+  void Erase (uint32_t slot);
+  void CompactExpiries (void);
+  uint32_t Find (uint8_t tid, WifiMacHeader::AddressType type, Mac48Address addr) const;
+  uint32_t FindFirstAvailable (const QosBlockedDestinations *blockedPackets) const;
+
+  std::vector<struct Item> m_items;
+  uint32_t m_head;
+  uint32_t m_tail;
+  uint32_t m_free;
+  uint32_t m_size;
+  Flows m_flows;
+  // a heap whose top is the earliest timestamp. The entries of the
+  // packets which left the queue are removed when they reach the top
+  // or when the heap is compacted.
+  std::vector<struct Expiry> m_expiries;
+  // the slot returned by the last Peek*, checked first by Remove.
+  uint32_t m_peeked;
+};
+
+} // namespace ns3
+
+#endif /* INDEXED_WIFI_MAC_QUEUE_H */
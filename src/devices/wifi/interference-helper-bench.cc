@@ -0,0 +1,137 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Drive an InterferenceHelper the way YansWifiPhy does, with synthetic
+ * signals which arrive as a Poisson process and overlap each other:
+ * every signal is added to the helper and the energy duration is
+ * queried, the receiver syncs to the signals which arrive while it is
+ * idle and the PER of those is computed at their end. --overlap is the
+ * mean number of signals on the medium at any time.
+ */
+
+#include "interference-helper.h"
+#include "yans-error-rate-model.h"
+#include "wifi-phy.h"
+#include "ns3/simulator.h"
+#include "ns3/random-variable.h"
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include <iostream>
+#include <math.h>
+
+using namespace ns3;
+
+class InterferenceBench
+{
+public:
+  InterferenceBench (uint32_t n, double overlap);
+  void Run (void);
+
+private:
+  void Arrive (void);
+  void EndReceive (Ptr<InterferenceHelper::Event> event);
+
+  InterferenceHelper m_interference;
+  uint32_t m_n;
+  uint32_t m_arrived;
+  uint32_t m_received;
+  double m_perSum;
+  bool m_rxing;
+  WifiMode m_mode;
+  ExponentialVariable m_interArrival;
+  UniformVariable m_size;
+  UniformVariable m_rxPowerDbm;
+};
+
+InterferenceBench::InterferenceBench (uint32_t n, double overlap)
+  : m_n (n),
+    m_arrived (0),
+    m_received (0),
+    m_perSum (0),
+    m_rxing (false),
+    m_mode (WifiPhy::GetOfdmRate24Mbps ()),
+    m_size (100, 1500),
+    m_rxPowerDbm (-95, -60)
+{
+  m_interference.SetNoiseFigure (pow (10.0, 7.0 / 10.0));
+  m_interference.SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  // the mean duration of the signals, divided by the mean number of
+  // signals on the medium.
+  Time meanDuration = InterferenceHelper::CalculateTxDuration (800, m_mode, WIFI_PREAMBLE_LONG);
+  m_interArrival = ExponentialVariable (meanDuration.GetSeconds () / overlap);
+}
+
+void
+InterferenceBench::Arrive (void)
+{
+  uint32_t size = m_size.GetInteger (100, 1500);
+  Time duration = InterferenceHelper::CalculateTxDuration (size, m_mode, WIFI_PREAMBLE_LONG);
+  double rxPowerW = pow (10.0, m_rxPowerDbm.GetValue () / 10.0) / 1000.0;
+  Ptr<InterferenceHelper::Event> event = m_interference.Add (size, m_mode, WIFI_PREAMBLE_LONG,
+                                                             duration, rxPowerW);
+  m_interference.GetEnergyDuration (pow (10.0, -62.0 / 10.0) / 1000.0);
+  if (!m_rxing)
+    {
+      m_rxing = true;
+      m_interference.NotifyRxStart ();
+      Simulator::Schedule (duration, &InterferenceBench::EndReceive, this, event);
+    }
+  m_arrived++;
+  if (m_arrived < m_n)
+    {
+      Simulator::Schedule (Seconds (m_interArrival.GetValue ()), &InterferenceBench::Arrive, this);
+    }
+}
+
+void
+InterferenceBench::EndReceive (Ptr<InterferenceHelper::Event> event)
+{
+  struct InterferenceHelper::SnrPer snrPer = m_interference.CalculateSnrPer (event);
+  m_interference.NotifyRxEnd ();
+  m_rxing = false;
+  m_received++;
+  m_perSum += snrPer.per;
+}
+
+void
+InterferenceBench::Run (void)
+{
+  Simulator::Schedule (Seconds (0.0), &InterferenceBench::Arrive, this);
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  uint64_t ms = clock.End ();
+  Simulator::Destroy ();
+  std::cout << "signals=" << m_arrived << " receptions=" << m_received
+            << " mean per=" << (m_received > 0 ? m_perSum / m_received : 0)
+            << " time=" << ms << "ms" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 100000;
+  double overlap = 10;
+
+  CommandLine cmd;
+  cmd.AddValue ("n", "The number of signals", n);
+  cmd.AddValue ("overlap", "The mean number of signals on the medium at any time", overlap);
+  cmd.Parse (argc, argv);
+
+  InterferenceBench bench (n, overlap);
+  bench.Run ();
+  return 0;
+}
@@ -24,6 +24,7 @@
 #include <iostream>
 #include "interference-helper.h"
 #include "wifi-phy.h"
+#include "yans-wifi-phy.h"
 
 NS_LOG_COMPONENT_DEFINE ("InterferenceHelperTxDurationTest");
 
@@ -176,6 +177,73 @@ InterferenceHelperTxDurationTest::DoRun (void)
   return (!retval);
 }
 
+/**
+ * Check that the durations which YansWifiPhy computes from the closed
+ * forms set up by ConfigureStandard are those of InterferenceHelper,
+ * for every mode of every standard and every size up to that of the
+ * largest A-MSDU.
+ */
+class YansWifiPhyTxDurationTest : public TestCase
+{
+public:
+  YansWifiPhyTxDurationTest ();
+  virtual bool DoRun (void);
+private:
+  bool CheckStandard (enum WifiPhyStandard standard);
+};
+
+YansWifiPhyTxDurationTest::YansWifiPhyTxDurationTest ()
+  : TestCase ("YansWifiPhy TX Duration")
+{}
+
+bool
+YansWifiPhyTxDurationTest::CheckStandard (enum WifiPhyStandard standard)
+{
+  // the default MaxAmsduSize of MsduStandardAggregator
+  const uint32_t maxSize = 7935;
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->ConfigureStandard (standard);
+  for (uint32_t i = 0; i < phy->GetNModes (); i++)
+    {
+      WifiMode mode = phy->GetMode (i);
+      for (uint32_t p = 0; p < 2; p++)
+        {
+          enum WifiPreamble preamble = (enum WifiPreamble)p;
+          for (uint32_t size = 0; size <= maxSize; size++)
+            {
+              Time expected = InterferenceHelper::CalculateTxDuration (size, mode, preamble);
+              Time calculated = phy->CalculateTxDuration (size, mode, preamble);
+              NS_TEST_ASSERT_MSG_EQ (calculated, expected, "standard=" << standard << " mode=" << mode
+                                     << " preamble=" << preamble << " size=" << size);
+            }
+        }
+    }
+  phy->Dispose ();
+  return false;
+}
+
+bool
+YansWifiPhyTxDurationTest::DoRun (void)
+{
+  enum WifiPhyStandard standards[] = {
+    WIFI_PHY_STANDARD_80211a,
+    WIFI_PHY_STANDARD_80211b,
+    WIFI_PHY_STANDARD_80211_10Mhz,
+    WIFI_PHY_STANDARD_80211_5Mhz,
+    WIFI_PHY_STANDARD_holland,
+    WIFI_PHY_STANDARD_80211p_CCH,
+    WIFI_PHY_STANDARD_80211p_SCH
+  };
+  for (uint32_t i = 0; i < sizeof (standards) / sizeof (standards[0]); i++)
+    {
+      if (CheckStandard (standards[i]))
+        {
+          return true;
+        }
+    }
+  return GetErrorStatus ();
+}
+
 class TxDurationTestSuite : public TestSuite
 {
 public:
@@ -186,6 +254,7 @@ TxDurationTestSuite::TxDurationTestSuite ()
   : TestSuite ("devices-wifi-tx-duration", UNIT)
 {
   AddTestCase (new InterferenceHelperTxDurationTest);
+  AddTestCase (new YansWifiPhyTxDurationTest);
 }
 
 TxDurationTestSuite g_txDurationTestSuite;
@@ -310,6 +310,22 @@ InterferenceHelper::GetPlcpPreambleDurationMicroSeconds (WifiMode payloadMode, W
     }
 }
 
+uint32_t
+InterferenceHelper::GetOfdmSymbolDurationMicroSeconds (WifiMode payloadMode)
+{
+  // IEEE Std 802.11-2007, section 17.3.2.3, table 17-4
+  // corresponds to T_{SYM} in the table
+  switch (payloadMode.GetBandwidth ()) {
+  case 20000000:
+  default:
+    return 4;
+  case 10000000:
+    return 8;
+  case 5000000:
+    return 16;
+  }
+}
+
 uint32_t 
 InterferenceHelper::GetPayloadDurationMicroSeconds (uint32_t size, WifiMode payloadMode)
 {
@@ -319,22 +335,7 @@ InterferenceHelper::GetPayloadDurationMicroSeconds (uint32_t size, WifiMode payl
     {
     case WIFI_MOD_CLASS_OFDM:
       {
-        // IEEE Std 802.11-2007, section 17.3.2.3, table 17-4
-        // corresponds to T_{SYM} in the table
-        uint32_t symbolDurationUs;
-
-        switch (payloadMode.GetBandwidth ()) {
-        case 20000000:
-        default:
-          symbolDurationUs = 4;
-          break;
-        case 10000000:
-          symbolDurationUs = 8;
-          break;
-        case 5000000:
-          symbolDurationUs = 16;
-          break;
-        }
+        uint32_t symbolDurationUs = GetOfdmSymbolDurationMicroSeconds (payloadMode);
 
         // IEEE Std 802.11-2007, section 17.3.2.2, table 17-3
         // corresponds to N_{DBPS} in the table
@@ -368,26 +369,52 @@ InterferenceHelper::CalculateTxDuration (uint32_t size, WifiMode payloadMode, Wi
   return MicroSeconds (duration);
 }
 
+struct InterferenceHelper::TxDurationForm
+InterferenceHelper::GetTxDurationForm (WifiMode payloadMode, WifiPreamble preamble)
+{
+  struct TxDurationForm form;
+  form.overheadUs = GetPlcpPreambleDurationMicroSeconds (payloadMode, preamble)
+    + GetPlcpHeaderDurationMicroSeconds (payloadMode, preamble);
+  switch (payloadMode.GetModulationClass ())
+    {
+    case WIFI_MOD_CLASS_OFDM:
+      // IEEE Std 802.11-2007, section 17.3.5.3, equation (17-11):
+      // the SERVICE field and the tail bits are sent with the payload.
+      form.extraBits = 16 + 6;
+      form.symbolUs = GetOfdmSymbolDurationMicroSeconds (payloadMode);
+      break;
+    case WIFI_MOD_CLASS_DSSS:
+      // IEEE Std 802.11-2007, section 18.2.3.5: the LENGTH field is
+      // rounded up to the microsecond.
+      form.extraBits = 0;
+      form.symbolUs = 1;
+      break;
+    default:
+      NS_FATAL_ERROR ("unsupported modulation class");
+      break;
+    }
+  form.symbolBitsE6 = (uint64_t)payloadMode.GetDataRate () * form.symbolUs;
+  return form;
+}
+
+Time
+InterferenceHelper::CalculateTxDuration (uint32_t size, const struct TxDurationForm &form)
+{
+  uint64_t bitsE6 = ((uint64_t)size * 8 + form.extraBits) * 1000000;
+  uint64_t numSymbols = (bitsE6 + form.symbolBitsE6 - 1) / form.symbolBitsE6;
+  return MicroSeconds (form.overheadUs + numSymbols * form.symbolUs);
+}
+
 void 
 InterferenceHelper::AppendEvent (Ptr<InterferenceHelper::Event> event)
 {
-  Time now = Simulator::Now ();
   if (!m_rxing)
     {
-      NiChanges::iterator nowIterator = GetPosition (now);
-      for (NiChanges::iterator i = m_niChanges.begin (); i != nowIterator; i++)
-        {
-          m_firstPower += i->GetDelta ();
-        }
-      m_niChanges.erase (m_niChanges.begin (), nowIterator);
-      m_niChanges.insert (m_niChanges.begin (), NiChange (event->GetStartTime (), event->GetRxPowerW ())); 
-    }
-  else
-    {
-      AddNiChangeEvent (NiChange (event->GetStartTime (), event->GetRxPowerW ()));
+      // the event is then the first change: it might be received.
+      Purge (Simulator::Now ());
     }
-  AddNiChangeEvent(NiChange (event->GetEndTime (), -event->GetRxPowerW ()));
-
+  AddNiChange (NiChange (event->GetStartTime (), event->GetRxPowerW ()));
+  AddNiChange (NiChange (event->GetEndTime (), -event->GetRxPowerW ()));
 }
 
 
@@ -406,21 +433,11 @@ InterferenceHelper::CalculateSnr (double signal, double noiseInterference, WifiM
 }
 
 double
-InterferenceHelper::CalculateNoiseInterferenceW (Ptr<InterferenceHelper::Event> event, NiChanges *ni) const
+InterferenceHelper::CalculateNoiseInterferenceW (Ptr<InterferenceHelper::Event> event) const
 {
-  double noiseInterference = m_firstPower;
   NS_ASSERT (m_rxing);
-  for (NiChanges::const_iterator i = m_niChanges.begin () + 1; i != m_niChanges.end (); i++)
-    {
-      if ((event->GetEndTime () == i->GetTime ()) && event->GetRxPowerW () == -i->GetDelta ())
-        {
-          break;
-        }
-      ni->push_back (*i);
-    }
-  ni->insert (ni->begin (), NiChange (event->GetStartTime (), noiseInterference));
-  ni->push_back (NiChange (event->GetEndTime (), 0));
-  return noiseInterference;
+  NS_ASSERT (!m_niChanges.empty () && m_niChanges.begin ()->GetTime () == event->GetStartTime ());
+  return m_firstPower;
 }
 
 double
@@ -436,23 +453,27 @@ InterferenceHelper::CalculateChunkSuccessRate (double snir, Time duration, WifiM
 }
 
 double 
-InterferenceHelper::CalculatePer (Ptr<const InterferenceHelper::Event> event, NiChanges *ni) const
+InterferenceHelper::CalculatePer (Ptr<const InterferenceHelper::Event> event) const
 {  
   double psr = 1.0; /* Packet Success Rate */
-  NiChanges::iterator j = ni->begin ();
-  Time previous = (*j).GetTime (); 
+  // the first change is the start of the event: the chunks are
+  // delimited by the next changes, up to the end of the event.
+  NiChanges::const_iterator j = m_niChanges.begin ();
+  Time previous = event->GetStartTime ();
   WifiMode payloadMode = event->GetPayloadMode ();
   WifiPreamble preamble = event->GetPreambleType ();
   WifiMode headerMode = GetPlcpHeaderMode (payloadMode, preamble);
-  Time plcpHeaderStart = (*j).GetTime () + MicroSeconds (GetPlcpPreambleDurationMicroSeconds (payloadMode, preamble));
+  Time plcpHeaderStart = previous + MicroSeconds (GetPlcpPreambleDurationMicroSeconds (payloadMode, preamble));
   Time plcpPayloadStart = plcpHeaderStart + MicroSeconds (GetPlcpHeaderDurationMicroSeconds (payloadMode, preamble));
-  double noiseInterferenceW = (*j).GetDelta ();
+  double noiseInterferenceW = m_firstPower;
   double powerW = event->GetRxPowerW ();
 
   j++;
-  while (ni->end () != j) 
+  while (true)
     {
-      Time current = (*j).GetTime ();
+      bool last = j == m_niChanges.end ()
+        || (j->GetTime () == event->GetEndTime () && j->GetDelta () == -powerW);
+      Time current = last ? event->GetEndTime () : j->GetTime ();
       NS_ASSERT (current >= previous);
     
       if (previous >= plcpPayloadStart) 
@@ -513,8 +534,12 @@ InterferenceHelper::CalculatePer (Ptr<const InterferenceHelper::Event> event, Ni
             }
         }
 
-      noiseInterferenceW += (*j).GetDelta ();
-      previous = (*j).GetTime ();
+      if (last)
+        {
+          break;
+        }
+      noiseInterferenceW += j->GetDelta ();
+      previous = current;
       j++;
     }
 
@@ -526,16 +551,14 @@ InterferenceHelper::CalculatePer (Ptr<const InterferenceHelper::Event> event, Ni
 struct InterferenceHelper::SnrPer 
 InterferenceHelper::CalculateSnrPer (Ptr<InterferenceHelper::Event> event)
 {
-  NiChanges ni;
-  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+  double noiseInterferenceW = CalculateNoiseInterferenceW (event);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
                              event->GetPayloadMode ());
   
-  /* calculate the SNIR at the start of the packet and accumulate
-   * all SNIR changes in the snir vector.
+  /* walk the SNIR changes from the start of the packet to its end.
    */
-  double per = CalculatePer (event, &ni);
+  double per = CalculatePer (event);
 
   struct SnrPer snrPer;
   snrPer.snr = snr;
@@ -549,16 +572,20 @@ InterferenceHelper::EraseEvents (void)
   m_niChanges.clear ();
   m_firstPower = 0.0;
 }
-InterferenceHelper::NiChanges::iterator
-InterferenceHelper::GetPosition (Time moment)
+void
+InterferenceHelper::Purge (Time moment)
 {
-  return std::upper_bound (m_niChanges.begin (), m_niChanges.end (), NiChange (moment, 0));
-
+  NiChanges::iterator end = std::upper_bound (m_niChanges.begin (), m_niChanges.end (), NiChange (moment, 0));
+  for (NiChanges::const_iterator i = m_niChanges.begin (); i != end; i++)
+    {
+      m_firstPower += i->GetDelta ();
+    }
+  m_niChanges.erase (m_niChanges.begin (), end);
 }
 void
-InterferenceHelper::AddNiChangeEvent (NiChange change)
+InterferenceHelper::AddNiChange (NiChange change)
 {
-  m_niChanges.insert (GetPosition (change.GetTime ()), change);
+  m_niChanges.insert (std::upper_bound (m_niChanges.begin (), m_niChanges.end (), change), change);
 }
 void
 InterferenceHelper::NotifyRxStart ()
@@ -569,5 +596,7 @@ void
 InterferenceHelper::NotifyRxEnd ()
 {
   m_rxing = false;
+  // the past changes are not needed anymore.
+  Purge (Simulator::Now ());
 }
 } // namespace ns3
@@ -21,8 +21,7 @@
 #define INTERFERENCE_HELPER_H
 
 #include <stdint.h>
-#include <vector>
-#include <list>
+#include <deque>
 #include "wifi-mode.h"
 #include "wifi-preamble.h"
 #include "wifi-phy-standard.h"
@@ -89,6 +88,25 @@ public:
   static uint32_t GetPlcpPreambleDurationMicroSeconds (WifiMode mode, WifiPreamble preamble);
   static uint32_t GetPayloadDurationMicroSeconds (uint32_t size, WifiMode payloadMode);
   static Time CalculateTxDuration (uint32_t size, WifiMode payloadMode, WifiPreamble preamble);
+
+  /**
+   * The closed form of CalculateTxDuration for a mode and a preamble:
+   * the duration (us) of a payload of size bytes is
+   * overheadUs + ceil ((8 * size + extraBits) * 1e6 / symbolBitsE6) * symbolUs
+   */
+  struct TxDurationForm
+  {
+    uint32_t overheadUs;   /**< the duration of the PLCP preamble and header */
+    uint32_t extraBits;    /**< the bits sent with the payload */
+    uint32_t symbolUs;     /**< the duration of a symbol */
+    uint64_t symbolBitsE6; /**< the data bits per symbol, times 1e6 */
+  };
+  static struct TxDurationForm GetTxDurationForm (WifiMode payloadMode, WifiPreamble preamble);
+  /**
+   * \returns the same duration as CalculateTxDuration for the mode and
+   *          preamble of form, with integer arithmetic only.
+   */
+  static Time CalculateTxDuration (uint32_t size, const struct TxDurationForm &form);
   Ptr<InterferenceHelper::Event> Add (uint32_t size, WifiMode payloadMode, 
 				      enum WifiPreamble preamble,
 				      Time duration, double rxPower);
@@ -108,26 +126,37 @@ private:
     Time m_time;
     double m_delta;
   };
-  typedef std::vector <NiChange> NiChanges;
-  typedef std::list<Ptr<Event> > Events;
+  /**
+   * The changes of the power on the medium, sorted by time. The
+   * changes which happen at the same time are kept in insertion order.
+   * Most changes are inserted close to the end and removed from the
+   * front.
+   */
+  typedef std::deque<NiChange> NiChanges;
 
   InterferenceHelper (const InterferenceHelper &o);
   InterferenceHelper &operator = (const InterferenceHelper &o);
   void AppendEvent (Ptr<Event> event);
-  double CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const;
+  double CalculateNoiseInterferenceW (Ptr<Event> event) const;
   double CalculateSnr (double signal, double noiseInterference, WifiMode mode) const;
   double CalculateChunkSuccessRate (double snir, Time delay, WifiMode mode) const;
-  double CalculatePer (Ptr<const Event> event, NiChanges *ni) const;
+  double CalculatePer (Ptr<const Event> event) const;
+  static uint32_t GetOfdmSymbolDurationMicroSeconds (WifiMode payloadMode);
 
   double m_noiseFigure; /**< noise figure (linear) */
   Ptr<ErrorRateModel> m_errorRateModel;
-  ///Experimental: needed for energy duration calculation
+  /**
+   * The changes which are not needed anymore are removed and
+   * accumulated in m_firstPower, the power on the medium before the
+   * first remaining change. While a packet is received, that first
+   * change is the start of the packet.
+   */
   NiChanges m_niChanges;
   double m_firstPower;
   bool m_rxing;
-  /// Returns an iterator to the first nichange, which is later than moment
-  NiChanges::iterator GetPosition (Time moment);
-  void AddNiChangeEvent (NiChange change);
+  /// Accumulates in m_firstPower the changes which happened at or before moment
+  void Purge (Time moment);
+  void AddNiChange (NiChange change);
 };
 
 } // namespace ns3
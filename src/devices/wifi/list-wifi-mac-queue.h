@@ -0,0 +1,93 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2005, 2009 INRIA
+ * Copyright (c) 2009 MIRKO BANCHI
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as 
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ * Author: Mirko Banchi <mk.banchi@gmail.com>
+ */
+#ifndef LIST_WIFI_MAC_QUEUE_H
+#define LIST_WIFI_MAC_QUEUE_H
+
+#include <list>
+#include "wifi-mac-queue.h"
+
+namespace ns3 {
+
+/**
+ * \brief a WifiMacQueue which keeps its packets in a list.
+ *
+ * The expired packets are looked for in the whole list whenever the
+ * queue is accessed, and the packets of a destination and TID are
+ * searched linearly.
+ */
+class ListWifiMacQueue : public WifiMacQueue
+{
+public:
+  static TypeId GetTypeId (void);
+  ListWifiMacQueue ();
+  virtual ~ListWifiMacQueue ();
+
+  virtual void PushFront (Ptr<const Packet> packet, const WifiMacHeader &hdr);
+  virtual Ptr<const Packet> Dequeue (WifiMacHeader *hdr);
+  virtual Ptr<const Packet> Peek (WifiMacHeader *hdr);
+  virtual Ptr<const Packet> DequeueByTidAndAddress (WifiMacHeader *hdr,
+                                                    uint8_t tid,
+                                                    WifiMacHeader::AddressType type,
+                                                    Mac48Address addr);
+  virtual Ptr<const Packet> PeekByTidAndAddress (WifiMacHeader *hdr,
+                                                 uint8_t tid,
+                                                 WifiMacHeader::AddressType type,
+                                                 Mac48Address addr);
+  virtual bool Remove (Ptr<const Packet> packet);
+  virtual uint32_t GetNPacketsByTidAndAddress (uint8_t tid,
+                                               WifiMacHeader::AddressType type,
+                                               Mac48Address addr);
+  virtual Ptr<const Packet> DequeueFirstAvailable (WifiMacHeader *hdr,
+                                                   Time &tStamp,
+                                                   const QosBlockedDestinations *blockedPackets);
+  virtual Ptr<const Packet> PeekFirstAvailable (WifiMacHeader *hdr,
+                                                Time &tStamp,
+                                                const QosBlockedDestinations *blockedPackets);
+  virtual void Flush (void);
+  virtual bool IsEmpty (void);
+  virtual uint32_t GetSize (void);
+
+private:
+  struct Item;
+  
+  typedef std::list<struct Item> PacketQueue;
+  typedef std::list<struct Item>::reverse_iterator PacketQueueRI;
+  typedef std::list<struct Item>::iterator PacketQueueI;
+  
+  virtual void Cleanup (void);
+  virtual void DoEnqueue (Ptr<const Packet> packet, const WifiMacHeader &hdr, Time tstamp);
+  
+  struct Item {
+    Item (Ptr<const Packet> packet, 
+          const WifiMacHeader &hdr, 
+          Time tstamp);
+    Ptr<const Packet> packet;
+    WifiMacHeader hdr;
+    Time tstamp;
+  };
+  PacketQueue m_queue;
+  uint32_t m_size;
+};
+
+} // namespace ns3
+
+#endif /* LIST_WIFI_MAC_QUEUE_H */
@@ -0,0 +1,317 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jason Ernst, University of Guelph
+ */
+#include "mixed-bias-delay-policy.h"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/log.h"
+#include <cmath>
+
+NS_LOG_COMPONENT_DEFINE ("MixedBiasDelayPolicy");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (MixedBiasDelayPolicy);
+NS_OBJECT_ENSURE_REGISTERED (AdaptiveMixedBiasDelayPolicy);
+
+TypeId
+MixedBiasDelayPolicy::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MixedBiasDelayPolicy")
+    .SetParent<WifiMacQueueDelayPolicy> ()
+    .AddConstructor<MixedBiasDelayPolicy> ()
+    .AddAttribute ("Alpha", "The weight of the weak bias beta1 against the strong bias beta2.",
+                   DoubleValue (0.5),
+                   MakeDoubleAccessor (&MixedBiasDelayPolicy::m_alpha),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+    .AddAttribute ("Beta1", "The exponent of the number of hops in the weak bias.",
+                   DoubleValue (2.0),
+                   MakeDoubleAccessor (&MixedBiasDelayPolicy::m_beta1),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("Beta2", "The exponent of the number of hops in the strong bias.",
+                   DoubleValue (5.0),
+                   MakeDoubleAccessor (&MixedBiasDelayPolicy::m_beta2),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("Delay", "How far in the future the timestamp of the packets which are delayed is, "
+                   "that is, how much longer they may stay in the queue before MaxDelay drops them.",
+                   TimeValue (Seconds (0.5)),
+                   MakeTimeAccessor (&MixedBiasDelayPolicy::m_delay),
+                   MakeTimeChecker ())
+    ;
+  return tid;
+}
+
+MixedBiasDelayPolicy::MixedBiasDelayPolicy ()
+  : m_uniform (0, 1)
+{}
+
+MixedBiasDelayPolicy::~MixedBiasDelayPolicy ()
+{}
+
+double
+MixedBiasDelayPolicy::GetAlpha (void) const
+{
+  return m_alpha;
+}
+
+double
+MixedBiasDelayPolicy::GetBeta1 (void) const
+{
+  return m_beta1;
+}
+
+double
+MixedBiasDelayPolicy::GetBeta2 (void) const
+{
+  return m_beta2;
+}
+
+Time
+MixedBiasDelayPolicy::GetDelay (Ptr<const Packet> packet, const WifiMacHeader &hdr, uint32_t hops)
+{
+  if (hops == 0)
+    {
+      return Seconds (0);
+    }
+  double r = 0.95;
+  if (hops != 1)
+    {
+      r = 5 * (m_alpha / std::pow (hops, m_beta1) + (1 - m_alpha) / std::pow (hops, m_beta2));
+    }
+  if (m_uniform.GetValue () > r)
+    {
+      NS_LOG_DEBUG ("delay packet " << packet->GetUid () << " hops=" << hops << " R=" << r);
+      return m_delay;
+    }
+  return Seconds (0);
+}
+
+TypeId
+AdaptiveMixedBiasDelayPolicy::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::AdaptiveMixedBiasDelayPolicy")
+    .SetParent<MixedBiasDelayPolicy> ()
+    .AddConstructor<AdaptiveMixedBiasDelayPolicy> ()
+    .AddAttribute ("TabuLife", "How long a solution cannot be moved to again.",
+                   TimeValue (Seconds (5.0)),
+                   MakeTimeAccessor (&AdaptiveMixedBiasDelayPolicy::m_tabuLife),
+                   MakeTimeChecker ())
+    .AddAttribute ("MovePeriod", "The number of packets whose timestamp is moved forward between two moves is this number plus one.",
+                   UintegerValue (5),
+                   MakeUintegerAccessor (&AdaptiveMixedBiasDelayPolicy::m_movePeriod),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("ResetPeriod", "After this number of moves, each move may go back to the best solution.",
+                   UintegerValue (50),
+                   MakeUintegerAccessor (&AdaptiveMixedBiasDelayPolicy::m_resetPeriod),
+                   MakeUintegerChecker<uint32_t> ())
+    ;
+  return tid;
+}
+
+AdaptiveMixedBiasDelayPolicy::AdaptiveMixedBiasDelayPolicy ()
+  : m_nDelayed (0),
+    m_nMoves (0),
+    m_bestUtility (-1),
+    m_received (0),
+    m_lost (0)
+{}
+
+AdaptiveMixedBiasDelayPolicy::~AdaptiveMixedBiasDelayPolicy ()
+{}
+
+void
+AdaptiveMixedBiasDelayPolicy::NotifyRxStats (uint32_t received, uint32_t lost, Time totalDelay)
+{
+  m_received = received;
+  m_lost = lost;
+  m_totalDelay = totalDelay;
+}
+
+double
+AdaptiveMixedBiasDelayPolicy::GetBestAlpha (void) const
+{
+  return m_bestUtility < 0 ? m_alpha : m_best.alpha;
+}
+
+double
+AdaptiveMixedBiasDelayPolicy::GetBestBeta1 (void) const
+{
+  return m_bestUtility < 0 ? m_beta1 : m_best.beta1;
+}
+
+double
+AdaptiveMixedBiasDelayPolicy::GetBestBeta2 (void) const
+{
+  return m_bestUtility < 0 ? m_beta2 : m_best.beta2;
+}
+
+Time
+AdaptiveMixedBiasDelayPolicy::GetDelay (Ptr<const Packet> packet, const WifiMacHeader &hdr, uint32_t hops)
+{
+  Time delay = MixedBiasDelayPolicy::GetDelay (packet, hdr, hops);
+  if (delay.IsStrictlyPositive ())
+    {
+      m_nDelayed++;
+      if (m_nDelayed > m_movePeriod)
+        {
+          m_nDelayed = 0;
+          Move ();
+        }
+    }
+  return delay;
+}
+
+double
+AdaptiveMixedBiasDelayPolicy::GetUtility (void) const
+{
+  double received = m_received == 0 ? 1 : m_received;
+  double delay = m_totalDelay.GetSeconds () / received;
+  double pdr = m_received / (received + m_lost);
+  if (delay == 0)
+    {
+      // nothing was received yet.
+      delay = 100000;
+    }
+  return 1 / delay + pdr;
+}
+
+void
+AdaptiveMixedBiasDelayPolicy::Move (void)
+{
+  Time now = Simulator::Now ();
+  for (std::vector<struct Tabu>::iterator i = m_tabus.begin (); i != m_tabus.end (); )
+    {
+      if (i->expiry < now)
+        {
+          i = m_tabus.erase (i);
+        }
+      else
+        {
+          i++;
+        }
+    }
+  m_nMoves++;
+
+  double utility = GetUtility ();
+  if (utility > m_bestUtility)
+    {
+      m_bestUtility = utility;
+      m_best.alpha = m_alpha;
+      m_best.beta1 = m_beta1;
+      m_best.beta2 = m_beta2;
+    }
+
+  struct Solution next = GetNeighbour ();
+  while (IsTabu (next))
+    {
+      next = GetNeighbour ();
+    }
+  m_alpha = next.alpha;
+  m_beta1 = next.beta1;
+  m_beta2 = next.beta2;
+  struct Tabu tabu;
+  tabu.solution = next;
+  tabu.expiry = now + m_tabuLife;
+  m_tabus.push_back (tabu);
+
+  // the aspiration criterion: the search may restart from the best solution.
+  if (m_nMoves > m_resetPeriod && m_uniform.GetValue () < 0.5)
+    {
+      m_alpha = m_best.alpha;
+      m_beta1 = m_best.beta1;
+      m_beta2 = m_best.beta2;
+      m_nMoves = 0;
+    }
+  NS_LOG_DEBUG ("utility=" << utility << " alpha=" << m_alpha << " beta1=" << m_beta1 << " beta2=" << m_beta2);
+}
+
+struct AdaptiveMixedBiasDelayPolicy::Solution
+AdaptiveMixedBiasDelayPolicy::GetNeighbour (void)
+{
+  // each parameter goes up or down one step with the probability 0.45,
+  // and takes a random value otherwise. A step out of its range resets
+  // the parameter to its default value.
+  struct Solution next;
+  next.alpha = 0.5;
+  next.beta1 = 2.0;
+  next.beta2 = 5.0;
+
+  double choice = m_uniform.GetValue ();
+  if (choice <= 0.45)
+    {
+      if (m_alpha + 0.1 < 1)
+        {
+          next.alpha = m_alpha + 0.1;
+        }
+    }
+  else if (choice <= 0.9)
+    {
+      if (m_alpha - 0.1 > 0)
+        {
+          next.alpha = m_alpha - 0.1;
+        }
+    }
+  else
+    {
+      next.alpha = m_uniform.GetValue ();
+    }
+
+  double *betas[2] = {&next.beta1, &next.beta2};
+  double currentBetas[2] = {m_beta1, m_beta2};
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      double beta = currentBetas[i];
+      choice = m_uniform.GetValue ();
+      if (choice <= 0.45)
+        {
+          if (beta + 0.5 < 7.5)
+            {
+              *betas[i] = beta + 0.5;
+            }
+        }
+      else if (choice <= 0.9)
+        {
+          if (beta - 0.5 > 0)
+            {
+              *betas[i] = beta - 0.5;
+            }
+        }
+      else
+        {
+          *betas[i] = static_cast<int> (m_uniform.GetValue () * 10);
+        }
+    }
+  return next;
+}
+
+bool
+AdaptiveMixedBiasDelayPolicy::IsTabu (const struct Solution &solution) const
+{
+  for (std::vector<struct Tabu>::const_iterator i = m_tabus.begin (); i != m_tabus.end (); i++)
+    {
+      if (i->solution.alpha == solution.alpha
+          && i->solution.beta1 == solution.beta1
+          && i->solution.beta2 == solution.beta2)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+} // namespace ns3
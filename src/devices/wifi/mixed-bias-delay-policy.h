@@ -0,0 +1,133 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jason Ernst, University of Guelph
+ */
+#ifndef MIXED_BIAS_DELAY_POLICY_H
+#define MIXED_BIAS_DELAY_POLICY_H
+
+#include <vector>
+#include "ns3/random-variable.h"
+#include "wifi-mac-queue-delay-policy.h"
+
+namespace ns3 {
+
+/**
+ * \brief the mixed bias delay policy.
+ *
+ * A packet whose destination is <i>h</i> hops away keeps the current
+ * time as its timestamp with the probability
+ * R = 5 (alpha / h^beta1 + (1 - alpha) / h^beta2),
+ * and 0.95 when h is 1, and its timestamp is moved forward by the
+ * "Delay" attribute otherwise, which lets it stay that much longer
+ * in the queue before MaxDelay drops it. The packets whose number of
+ * hops is not known are never delayed.
+ */
+class MixedBiasDelayPolicy : public WifiMacQueueDelayPolicy
+{
+public:
+  static TypeId GetTypeId (void);
+  MixedBiasDelayPolicy ();
+  virtual ~MixedBiasDelayPolicy ();
+
+  virtual Time GetDelay (Ptr<const Packet> packet, const WifiMacHeader &hdr, uint32_t hops);
+
+  double GetAlpha (void) const;
+  double GetBeta1 (void) const;
+  double GetBeta2 (void) const;
+
+protected:
+  double m_alpha;
+  double m_beta1;
+  double m_beta2;
+  Time m_delay;
+  UniformVariable m_uniform;
+};
+
+/**
+ * \brief a mixed bias delay policy which tunes its parameters by a tabu search.
+ *
+ * Every "MovePeriod" packets whose timestamp it moved forward, the policy rates its current
+ * (alpha, beta1, beta2) by the utility 1 / delay + pdr of the
+ * received packets, remembers the best ones and moves to a
+ * neighbouring solution which was not tried during the last
+ * "TabuLife". After "ResetPeriod" moves, it goes back to the best
+ * solution with the probability 0.5.
+ *
+ * The delay and the packet delivery ratio come from NotifyRxStats,
+ * which can be connected to the "RxStats" trace source of the
+ * ns3::UdpServer of the destination. A policy which is never
+ * notified rates all the solutions alike and keeps the first one as
+ * the best. Since these statistics are end to end, they cannot tell
+ * apart the queues of a node: MeshHelper gives all the queues of a mesh
+ * point, over its access classes and interfaces, a single policy which
+ * counts the moves over all of them.
+ */
+class AdaptiveMixedBiasDelayPolicy : public MixedBiasDelayPolicy
+{
+public:
+  static TypeId GetTypeId (void);
+  AdaptiveMixedBiasDelayPolicy ();
+  virtual ~AdaptiveMixedBiasDelayPolicy ();
+
+  virtual Time GetDelay (Ptr<const Packet> packet, const WifiMacHeader &hdr, uint32_t hops);
+
+  /**
+   * \param received the number of packets received so far.
+   * \param lost the number of packets lost so far.
+   * \param totalDelay the sum of the delays of the received packets.
+   */
+  void NotifyRxStats (uint32_t received, uint32_t lost, Time totalDelay);
+
+  double GetBestAlpha (void) const;
+  double GetBestBeta1 (void) const;
+  double GetBestBeta2 (void) const;
+
+private:
+  struct Solution
+  {
+    double alpha;
+    double beta1;
+    double beta2;
+  };
+  struct Tabu
+  {
+    struct Solution solution;
+    Time expiry;
+  };
+
+  void Move (void);
+  double GetUtility (void) const;
+  struct Solution GetNeighbour (void);
+  bool IsTabu (const struct Solution &solution) const;
+
+  Time m_tabuLife;
+  uint32_t m_movePeriod;
+  uint32_t m_resetPeriod;
+
+  uint32_t m_nDelayed;
+  uint32_t m_nMoves;
+  struct Solution m_best;
+  double m_bestUtility;
+  std::vector<struct Tabu> m_tabus;
+
+  uint32_t m_received;
+  uint32_t m_lost;
+  Time m_totalDelay;
+};
+
+} // namespace ns3
+
+#endif /* MIXED_BIAS_DELAY_POLICY_H */
@@ -0,0 +1,124 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/pointer.h"
+#include "ns3/double.h"
+#include "table-error-rate-model.h"
+#include "yans-error-rate-model.h"
+#include "nist-error-rate-model.h"
+#include "wifi-phy.h"
+#include <math.h>
+
+namespace ns3 {
+
+class TableErrorRateModelTestCase : public TestCase
+{
+public:
+  TableErrorRateModelTestCase (Ptr<ErrorRateModel> model, std::string name);
+  virtual ~TableErrorRateModelTestCase ();
+
+private:
+  virtual bool DoRun (void);
+  bool CheckMode (Ptr<ErrorRateModel> table, WifiMode mode);
+
+  Ptr<ErrorRateModel> m_model;
+  double m_maxRelativeError;
+};
+
+TableErrorRateModelTestCase::TableErrorRateModelTestCase (Ptr<ErrorRateModel> model, std::string name)
+  : TestCase ("Check the interpolation of the " + name),
+    m_model (model),
+    m_maxRelativeError (1e-3)
+{}
+
+TableErrorRateModelTestCase::~TableErrorRateModelTestCase ()
+{}
+
+bool
+TableErrorRateModelTestCase::CheckMode (Ptr<ErrorRateModel> table, WifiMode mode)
+{
+  // the error bound is checked only at the middle of the intervals of
+  // the tables: allow some slack elsewhere.
+  double tolerance = 2 * m_maxRelativeError / exp (1.0);
+  uint32_t nbits[5] = {1, 24, 8 * 14, 8 * 1500, 8 * 2304};
+  // the SNRs are not aligned with the grids of the tables and span
+  // beyond their bounds.
+  for (double snrDb = -12.0; snrDb < 52.0; snrDb += 0.0137)
+    {
+      double snr = pow (10.0, snrDb / 10.0);
+      for (uint32_t i = 0; i < 5; i++)
+        {
+          double expected = m_model->GetChunkSuccessRate (mode, snr, nbits[i]);
+          double actual = table->GetChunkSuccessRate (mode, snr, nbits[i]);
+          NS_TEST_ASSERT_MSG_EQ_TOL (actual, expected, tolerance,
+                                     "mode=" << mode << " snr=" << snrDb << "dB nbits=" << nbits[i]);
+        }
+    }
+  return false;
+}
+
+bool
+TableErrorRateModelTestCase::DoRun (void)
+{
+  Ptr<TableErrorRateModel> table = CreateObject<TableErrorRateModel> ();
+  table->SetAttribute ("MaxRelativeError", DoubleValue (m_maxRelativeError));
+  table->SetErrorRateModel (m_model);
+
+  WifiMode modes[] = {
+    WifiPhy::GetDsssRate1Mbps (),
+    WifiPhy::GetDsssRate2Mbps (),
+    WifiPhy::GetDsssRate5_5Mbps (),
+    WifiPhy::GetDsssRate11Mbps (),
+    WifiPhy::GetOfdmRate6Mbps (),
+    WifiPhy::GetOfdmRate9Mbps (),
+    WifiPhy::GetOfdmRate12Mbps (),
+    WifiPhy::GetOfdmRate18Mbps (),
+    WifiPhy::GetOfdmRate24Mbps (),
+    WifiPhy::GetOfdmRate36Mbps (),
+    WifiPhy::GetOfdmRate48Mbps (),
+    WifiPhy::GetOfdmRate54Mbps (),
+    WifiPhy::GetOfdmRate3MbpsBW10MHz (),
+    WifiPhy::GetOfdmRate27MbpsBW10MHz (),
+    WifiPhy::GetOfdmRate1_5MbpsBW5MHz (),
+    WifiPhy::GetOfdmRate13_5MbpsBW5MHz ()
+  };
+  for (uint32_t i = 0; i < sizeof (modes) / sizeof (modes[0]); i++)
+    {
+      if (CheckMode (table, modes[i]))
+        {
+          return true;
+        }
+    }
+  return GetErrorStatus ();
+}
+
+class TableErrorRateModelTestSuite : public TestSuite
+{
+public:
+  TableErrorRateModelTestSuite ();
+};
+
+TableErrorRateModelTestSuite::TableErrorRateModelTestSuite ()
+  : TestSuite ("devices-wifi-table-error-rate-model", UNIT)
+{
+  AddTestCase (new TableErrorRateModelTestCase (CreateObject<YansErrorRateModel> (), "YansErrorRateModel"));
+  AddTestCase (new TableErrorRateModelTestCase (CreateObject<NistErrorRateModel> (), "NistErrorRateModel"));
+}
+
+static TableErrorRateModelTestSuite g_tableErrorRateModelTestSuite;
+
+} // namespace ns3
@@ -0,0 +1,208 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "table-error-rate-model.h"
+#include "ns3/pointer.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include <math.h>
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("TableErrorRateModel");
+
+namespace ns3 {
+
+// the step of the grids is halved from the first value until the
+// interpolation is accurate enough or the last value is reached.
+static const double INITIAL_STEP_DB = 0.1;
+static const double MIN_STEP_DB = 0.001;
+// the values of y below this one are compared in absolute terms: they
+// are close to the resolution of the bit success rates of the wrapped
+// models which is that of a double close to 1.
+static const double MIN_RELATIVE_Y = 1e-12;
+// the values of y beyond this one are not interpolated: y diverges
+// when the bit error rate of the wrapped models approaches 1 and
+// cannot be interpolated accurately there. The chunks, even of a
+// single bit, are then lost more often than not anyway.
+static const double MAX_Y = 1.0;
+
+NS_OBJECT_ENSURE_REGISTERED (TableErrorRateModel);
+
+TypeId
+TableErrorRateModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TableErrorRateModel")
+    .SetParent<ErrorRateModel> ()
+    .AddConstructor<TableErrorRateModel> ()
+    .AddAttribute ("ErrorRateModel", "The error rate model which is interpolated.",
+                   PointerValue (),
+                   MakePointerAccessor (&TableErrorRateModel::SetErrorRateModel,
+                                        &TableErrorRateModel::GetErrorRateModel),
+                   MakePointerChecker<ErrorRateModel> ())
+    .AddAttribute ("MinSnr", "The lowest SNR (dB) of the tables.",
+                   DoubleValue (-10.0),
+                   MakeDoubleAccessor (&TableErrorRateModel::m_minSnrDb),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("MaxSnr", "The highest SNR (dB) of the tables.",
+                   DoubleValue (50.0),
+                   MakeDoubleAccessor (&TableErrorRateModel::m_maxSnrDb),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("MaxRelativeError",
+                   "The largest relative error of the interpolated bit error exponents, "
+                   "checked at the middle of each interval of the tables.",
+                   DoubleValue (1e-3),
+                   MakeDoubleAccessor (&TableErrorRateModel::m_maxRelativeError),
+                   MakeDoubleChecker<double> (0.0))
+    ;
+  return tid;
+}
+
+TableErrorRateModel::TableErrorRateModel ()
+{}
+
+TableErrorRateModel::~TableErrorRateModel ()
+{}
+
+void
+TableErrorRateModel::DoDispose (void)
+{
+  m_tables.clear ();
+  m_model = 0;
+  ErrorRateModel::DoDispose ();
+}
+
+void
+TableErrorRateModel::SetErrorRateModel (Ptr<ErrorRateModel> model)
+{
+  m_tables.clear ();
+  m_model = model;
+}
+
+Ptr<ErrorRateModel>
+TableErrorRateModel::GetErrorRateModel (void) const
+{
+  return m_model;
+}
+
+double
+TableErrorRateModel::GetBitErrorExponent (WifiMode mode, double snrDb) const
+{
+  double csr = m_model->GetChunkSuccessRate (mode, pow (10.0, snrDb / 10.0), 1);
+  return -log (csr);
+}
+
+void
+TableErrorRateModel::FillTable (WifiMode mode, double step, struct Table *table) const
+{
+  uint32_t n = (uint32_t)ceil ((m_maxSnrDb - m_minSnrDb) / step) + 1;
+  table->step = step;
+  table->y.resize (n);
+  table->logY.resize (n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      table->y[i] = GetBitErrorExponent (mode, m_minSnrDb + i * step);
+      table->logY[i] = log (table->y[i]);
+    }
+}
+
+bool
+TableErrorRateModel::IsAccurate (WifiMode mode, const struct Table &table) const
+{
+  for (uint32_t i = 0; i + 1 < table.y.size (); i++)
+    {
+      double snrDb = m_minSnrDb + (i + 0.5) * table.step;
+      double y;
+      if (!Interpolate (table, snrDb, &y))
+        {
+          continue;
+        }
+      double exact = GetBitErrorExponent (mode, snrDb);
+      if (fabs (y - exact) > m_maxRelativeError * std::max (exact, MIN_RELATIVE_Y))
+        {
+          NS_LOG_DEBUG ("mode=" << mode << " step=" << table.step << "dB snr=" << snrDb <<
+                        "dB y=" << y << " exact=" << exact);
+          return false;
+        }
+    }
+  return true;
+}
+
+const struct TableErrorRateModel::Table &
+TableErrorRateModel::GetTable (WifiMode mode) const
+{
+  Tables::iterator i = m_tables.find (mode.GetUid ());
+  if (i != m_tables.end ())
+    {
+      return i->second;
+    }
+  struct Table &table = m_tables[mode.GetUid ()];
+  double step = INITIAL_STEP_DB;
+  FillTable (mode, step, &table);
+  while (!IsAccurate (mode, table))
+    {
+      if (step / 2 < MIN_STEP_DB)
+        {
+          NS_LOG_WARN ("The table of " << mode << " is not accurate with a step of " << step << "dB");
+          break;
+        }
+      step /= 2;
+      FillTable (mode, step, &table);
+    }
+  NS_LOG_DEBUG ("mode=" << mode << " step=" << table.step << "dB size=" << table.y.size ());
+  return table;
+}
+
+bool
+TableErrorRateModel::Interpolate (const struct Table &table, double snrDb, double *y) const
+{
+  double x = (snrDb - m_minSnrDb) / table.step;
+  if (!(x >= 0) || x >= table.y.size () - 1)
+    {
+      return false;
+    }
+  uint32_t i = (uint32_t)x;
+  double y0 = table.y[i];
+  double y1 = table.y[i + 1];
+  if (y0 == 0 && y1 == 0)
+    {
+      *y = 0;
+      return true;
+    }
+  if (!(y0 > 0 && y0 <= MAX_Y && y1 > 0 && y1 <= MAX_Y))
+    {
+      // the bit success rate reaches 1 or gets too low in this interval.
+      return false;
+    }
+  double alpha = x - i;
+  *y = exp (table.logY[i] + alpha * (table.logY[i + 1] - table.logY[i]));
+  return true;
+}
+
+double
+TableErrorRateModel::GetChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const
+{
+  NS_ASSERT (m_model != 0);
+  if (snr > 0)
+    {
+      double y;
+      if (Interpolate (GetTable (mode), 10.0 * log10 (snr), &y))
+        {
+          return exp (-(double)nbits * y);
+        }
+    }
+  return m_model->GetChunkSuccessRate (mode, snr, nbits);
+}
+
+} // namespace ns3
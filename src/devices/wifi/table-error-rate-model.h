@@ -0,0 +1,97 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef TABLE_ERROR_RATE_MODEL_H
+#define TABLE_ERROR_RATE_MODEL_H
+
+#include <stdint.h>
+#include <vector>
+#include <map>
+#include "wifi-mode.h"
+#include "error-rate-model.h"
+#include "ns3/ptr.h"
+
+namespace ns3 {
+
+/**
+ * \brief interpolate the chunk success rates of another error rate model
+ *
+ * The error rate models which are shipped with ns-3 compute a chunk
+ * success rate of the form pow (csr, nbits) where csr is the success
+ * rate of a single bit. This model tabulates, for each WifiMode,
+ * y = -log (csr) over a grid of SNRs spaced uniformly in dB, and
+ * computes exp (-nbits * y) where y is interpolated linearly in the
+ * log domain between the two nearest points of the grid.
+ *
+ * The table of a WifiMode is built on its first use. Its step starts
+ * at 0.1dB and is halved until the interpolated value of y at the
+ * middle of every interval of the grid is within MaxRelativeError of
+ * the value computed by the wrapped model. Since x * exp (-x) <= 1/e,
+ * the chunk success rates are then within about MaxRelativeError / e
+ * of those of the wrapped model, whatever the size of the chunk.
+ *
+ * The SNRs outside of [MinSnr, MaxSnr] and the intervals of the grid
+ * where the bit success rate of the wrapped model reaches 1 or falls
+ * below 1/e are computed by the wrapped model.
+ *
+ * The attributes MinSnr, MaxSnr and MaxRelativeError must be set
+ * before the first use of the model.
+ */
+class TableErrorRateModel : public ErrorRateModel
+{
+public:
+  static TypeId GetTypeId (void);
+
+  TableErrorRateModel ();
+  virtual ~TableErrorRateModel ();
+
+  /**
+   * \param model the error rate model to interpolate.
+   */
+  void SetErrorRateModel (Ptr<ErrorRateModel> model);
+  /**
+   * \returns the error rate model which is interpolated.
+   */
+  Ptr<ErrorRateModel> GetErrorRateModel (void) const;
+
+  virtual double GetChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const;
+
+private:
+  struct Table
+  {
+    double step;
+    // -log of the bit success rate, and its log, for each point of the grid.
+    std::vector<double> y;
+    std::vector<double> logY;
+  };
+  typedef std::map<uint32_t, struct Table> Tables;
+
+  virtual void DoDispose (void);
+  const struct Table &GetTable (WifiMode mode) const;
+  void FillTable (WifiMode mode, double step, struct Table *table) const;
+  bool IsAccurate (WifiMode mode, const struct Table &table) const;
+  bool Interpolate (const struct Table &table, double snrDb, double *y) const;
+  double GetBitErrorExponent (WifiMode mode, double snrDb) const;
+
+  Ptr<ErrorRateModel> m_model;
+  double m_minSnrDb;
+  double m_maxSnrDb;
+  double m_maxRelativeError;
+  mutable Tables m_tables;
+};
+
+} // namespace ns3
+
+#endif /* TABLE_ERROR_RATE_MODEL_H */
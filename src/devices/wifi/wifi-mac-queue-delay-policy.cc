@@ -0,0 +1,44 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "wifi-mac-queue-delay-policy.h"
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (WifiMacQueueDelayPolicy);
+
+TypeId
+WifiMacQueueDelayPolicy::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::WifiMacQueueDelayPolicy")
+    .SetParent<Object> ()
+    .AddConstructor<WifiMacQueueDelayPolicy> ()
+    ;
+  return tid;
+}
+
+WifiMacQueueDelayPolicy::WifiMacQueueDelayPolicy ()
+{}
+
+WifiMacQueueDelayPolicy::~WifiMacQueueDelayPolicy ()
+{}
+
+Time
+WifiMacQueueDelayPolicy::GetDelay (Ptr<const Packet> packet, const WifiMacHeader &hdr, uint32_t hops)
+{
+  return Seconds (0);
+}
+
+} // namespace ns3
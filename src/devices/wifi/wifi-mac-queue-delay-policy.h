@@ -0,0 +1,61 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef WIFI_MAC_QUEUE_DELAY_POLICY_H
+#define WIFI_MAC_QUEUE_DELAY_POLICY_H
+
+#include "ns3/object.h"
+#include "ns3/packet.h"
+#include "ns3/nstime.h"
+#include "wifi-mac-header.h"
+
+namespace ns3 {
+
+/**
+ * \brief decides how much later than now the timestamp of a packet
+ *        enqueued in a WifiMacQueue is.
+ *
+ * A packet delayed by <i>d</i> is appended to the queue at once, in
+ * its usual position, and can be dequeued right away: only its
+ * timestamp is <i>d</i> in the future. Since the queue drops the
+ * packets whose timestamp is older than its MaxDelay, the packet can
+ * stay up to MaxDelay + <i>d</i> in the queue before it is dropped.
+ *
+ * Each WifiMacQueue creates its own policy from its "DelayPolicy"
+ * attribute unless one is given to WifiMacQueue::SetDelayPolicy, which
+ * lets several queues share the state of a policy: MeshHelper shares a
+ * single policy between all the queues of a mesh point. This base class
+ * delays no packet.
+ */
+class WifiMacQueueDelayPolicy : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+  WifiMacQueueDelayPolicy ();
+  virtual ~WifiMacQueueDelayPolicy ();
+
+  /**
+   * \param packet the packet being enqueued.
+   * \param hdr the header of <i>packet</i>.
+   * \param hops the number of hops from this node to the destination
+   *        of <i>packet</i>, or 0 if it is not known.
+   * \returns how far in the future the timestamp of <i>packet</i> is.
+   */
+  virtual Time GetDelay (Ptr<const Packet> packet, const WifiMacHeader &hdr, uint32_t hops);
+};
+
+} // namespace ns3
+
+#endif /* WIFI_MAC_QUEUE_DELAY_POLICY_H */
@@ -22,38 +22,20 @@
 #ifndef WIFI_MAC_QUEUE_H
 #define WIFI_MAC_QUEUE_H
 
-#include <list>
 #include <utility>
 #include "ns3/packet.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
+#include "ns3/object-factory.h"
+#include "ns3/callback.h"
 #include "wifi-mac-header.h"
-#include "wifi-phy.h"
+#include "wifi-mac-queue-delay-policy.h"
 
 namespace ns3 {
 
 class WifiMacParameters;
 class QosBlockedDestinations;
 
-/* Added by Jason for Adaptive MB */
-class Solution {
-  public:
-	double ALPHA;	//solution params
-	double BETA1;	
-	double BETA2;
-	double utility;	//solution utility value
-	Solution();
-};
-
-/* Added by Jason for Adaptive MB */
-class Tabu {
-  public:
-	double ALPHA;
-	double BETA1;
-	double BETA2;
-	Time expiry;
-};
-
 /**
  * \brief a 802.11e-specific queue.
  *
@@ -68,23 +50,60 @@ class Tabu {
  * to verify whether or not it should be dropped. If 
  * dot11EDCATableMSDULifetime has elapsed, it is dropped.
  * Otherwise, it is returned to the caller.
+ *
+ * This is the interface of the queues of ns3::DcaTxop and
+ * ns3::EdcaTxopN: ns3::ListWifiMacQueue keeps the packets in a list
+ * which is searched linearly while ns3::IndexedWifiMacQueue indexes
+ * them by destination and TID. The "WifiMacQueueType" global value
+ * selects the implementation which CreateDefault returns.
+ *
+ * The timestamp of a packet may also be set in the future when it is
+ * enqueued, which extends its lifetime in the queue, according to the
+ * ns3::WifiMacQueueDelayPolicy of the queue.
  */
 class WifiMacQueue : public Object
 {
 public:  
+  /**
+   * Returns the number of hops to the destination of a packet, or 0
+   * if it is not known.
+   */
+  typedef Callback<uint32_t, const WifiMacHeader &> HopCountCallback;
+
   static TypeId GetTypeId (void);
   WifiMacQueue ();
-  ~WifiMacQueue ();
+  virtual ~WifiMacQueue ();
+
+  /**
+   * \returns a new queue of the type of the "WifiMacQueueType" global value.
+   */
+  static Ptr<WifiMacQueue> CreateDefault (void);
 
   void SetMaxSize (uint32_t maxSize);
   void SetMaxDelay (Time delay);
   uint32_t GetMaxSize (void) const;
   Time GetMaxDelay (void) const;
+  /**
+   * \returns the delay policy of this queue, created from the
+   * "DelayPolicy" attribute when it is first needed.
+   */
+  Ptr<WifiMacQueueDelayPolicy> GetDelayPolicy (void);
+  /**
+   * \param policy the delay policy of this queue, in place of the one
+   *        created from the "DelayPolicy" attribute. It may be shared
+   *        with other queues.
+   */
+  void SetDelayPolicy (Ptr<WifiMacQueueDelayPolicy> policy);
+  /**
+   * \param callback the callback which gives the number of hops passed
+   *        to the delay policy. Without it, the number of hops is 0.
+   */
+  void SetHopCountCallback (HopCountCallback callback);
 
   void Enqueue (Ptr<const Packet> packet, const WifiMacHeader &hdr);
-  void PushFront (Ptr<const Packet> packet, const WifiMacHeader &hdr);
-  Ptr<const Packet> Dequeue (WifiMacHeader *hdr);
-  Ptr<const Packet> Peek (WifiMacHeader *hdr);
+  virtual void PushFront (Ptr<const Packet> packet, const WifiMacHeader &hdr) = 0;
+  virtual Ptr<const Packet> Dequeue (WifiMacHeader *hdr) = 0;
+  virtual Ptr<const Packet> Peek (WifiMacHeader *hdr) = 0;
   /**
    * Searchs and returns, if is present in this queue, first packet having 
    * address indicated by <i>type</i> equals to <i>addr</i>, and tid 
@@ -92,10 +111,10 @@ public:
    * Is typically used by ns3::EdcaTxopN in order to perform correct MSDU 
    * aggregation (A-MSDU).
    */
-  Ptr<const Packet> DequeueByTidAndAddress (WifiMacHeader *hdr,
-                                            uint8_t tid, 
-                                            WifiMacHeader::AddressType type,
-                                            Mac48Address addr);
+  virtual Ptr<const Packet> DequeueByTidAndAddress (WifiMacHeader *hdr,
+                                                    uint8_t tid, 
+                                                    WifiMacHeader::AddressType type,
+                                                    Mac48Address addr) = 0;
   /**
    * Searchs and returns, if is present in this queue, first packet having
    * address indicated by <i>type</i> equals to <i>addr</i>, and tid 
@@ -103,23 +122,22 @@ public:
    * Is typically used by ns3::EdcaTxopN in order to perform correct MSDU
    * aggregation (A-MSDU).
    */
-  Ptr<const Packet> PeekByTidAndAddress (WifiMacHeader *hdr,
-                                         uint8_t tid,
-                                         WifiMacHeader::AddressType type,
-                                         Mac48Address addr);
+  virtual Ptr<const Packet> PeekByTidAndAddress (WifiMacHeader *hdr,
+                                                 uint8_t tid,
+                                                 WifiMacHeader::AddressType type,
+                                                 Mac48Address addr) = 0;
   /**
    * If exists, removes <i>packet</i> from queue and returns true. Otherwise it
-   * takes no effects and return false. Deletion of the packet is
-   * performed in linear time (O(n)).  
+   * takes no effects and return false.
    */
-  bool Remove (Ptr<const Packet> packet);
+  virtual bool Remove (Ptr<const Packet> packet) = 0;
   /**
    * Returns number of QoS packets having tid equals to <i>tid</i> and address
    * specified by <i>type</i> equals to <i>addr</i>.
    */
-  uint32_t GetNPacketsByTidAndAddress (uint8_t tid,
-                                       WifiMacHeader::AddressType type,
-                                       Mac48Address addr);
+  virtual uint32_t GetNPacketsByTidAndAddress (uint8_t tid,
+                                               WifiMacHeader::AddressType type,
+                                               Mac48Address addr) = 0;
   /**
    * Returns first available packet for transmission. A packet could be no available
    * if it's a QoS packet with a tid and an address1 fields equal to <i>tid</i> and <i>addr</i>
@@ -127,62 +145,44 @@ public:
    * So that packet must not be transmitted until reception of an ADDBA response frame from station
    * addressed by <i>addr</i>. This method removes the packet from queue. 
    */
-  Ptr<const Packet> DequeueFirstAvailable (WifiMacHeader *hdr,
-                                           Time &tStamp,
-                                           const QosBlockedDestinations *blockedPackets);
+  virtual Ptr<const Packet> DequeueFirstAvailable (WifiMacHeader *hdr,
+                                                   Time &tStamp,
+                                                   const QosBlockedDestinations *blockedPackets) = 0;
   /**
    * Returns first available packet for transmission. The packet isn't removed from queue.
    */
-  Ptr<const Packet> PeekFirstAvailable (WifiMacHeader *hdr,
-                                        Time &tStamp,
-                                        const QosBlockedDestinations *blockedPackets);
-  void Flush (void);
+  virtual Ptr<const Packet> PeekFirstAvailable (WifiMacHeader *hdr,
+                                                Time &tStamp,
+                                                const QosBlockedDestinations *blockedPackets) = 0;
+  virtual void Flush (void) = 0;
+
+  virtual bool IsEmpty (void) = 0;
+  virtual uint32_t GetSize (void) = 0;
+
+protected:
+  virtual void DoDispose (void);
+  /**
+   * Drops the packets which stayed longer than the max delay in the queue.
+   */
+  virtual void Cleanup (void) = 0;
+  /**
+   * Appends <i>packet</i> to the queue, with the timestamp <i>tstamp</i>
+   * from which its delay in the queue is counted. Enqueue checks that
+   * the queue is not full first.
+   */
+  virtual void DoEnqueue (Ptr<const Packet> packet, const WifiMacHeader &hdr, Time tstamp) = 0;
+  static Mac48Address GetAddress (enum WifiMacHeader::AddressType type, const WifiMacHeader &hdr);
 
-  bool IsEmpty (void);
-  uint32_t GetSize (void);
-  
-  //added by jason
-  void SetPhy(Ptr<WifiPhy> phy);
-  void ComputeDistance(const WifiMacHeader &hdr);
-  
 private:
-  struct Item;
-  
-  typedef std::list<struct Item> PacketQueue;
-  typedef std::list<struct Item>::reverse_iterator PacketQueueRI;
-  typedef std::list<struct Item>::iterator PacketQueueI;
-  
-  void Cleanup (void);
-  Mac48Address GetAddressForPacket (enum WifiMacHeader::AddressType type, PacketQueueI);
-  
-  struct Item {
-    Item (Ptr<const Packet> packet, 
-          const WifiMacHeader &hdr, 
-          Time tstamp);
-    Ptr<const Packet> packet;
-    WifiMacHeader hdr;
-    Time tstamp;
-  };
-  PacketQueue m_queue;
-  WifiMacParameters *m_parameters;
-  uint32_t m_size;
+  static ObjectFactory GetDefaultDelayPolicyFactory (void);
+
   uint32_t m_maxSize;
   Time m_maxDelay;
-  
-  //added by jason
-  Ptr<WifiPhy> m_phy;
-  double distance;
-  
-  bool IsTabu(Solution potential);
-  Solution GetPotentialSolution();
+  ObjectFactory m_delayPolicyFactory;
+  Ptr<WifiMacQueueDelayPolicy> m_delayPolicy;
+  HopCountCallback m_hopCountCallback;
 };
 
-static int packetCount;
-static int iterationCount; 
-static Solution best;
-static Solution current;
-static std::vector<Tabu> tabuList;
-
 } // namespace ns3
 
 #endif /* WIFI_MAC_QUEUE_H */
@@ -22,6 +22,7 @@
 
 #include <vector>
 #include <utility>
+#include <tr1/unordered_map>
 #include "ns3/mac48-address.h"
 #include "ns3/traced-callback.h"
 #include "ns3/packet.h"
@@ -396,9 +397,20 @@ private:
 
   typedef std::vector <WifiRemoteStation *> Stations;
   typedef std::vector <WifiRemoteStationState *> StationStates;
+  typedef std::pair<Mac48Address, uint8_t> StationKey;
+  class StationKeyHash : public std::unary_function<StationKey, size_t>
+  {
+  public:
+    size_t operator () (StationKey const &x) const;
+  };
+  typedef std::tr1::unordered_map<Mac48Address, WifiRemoteStationState *, Mac48AddressHash> StationStateIndex;
+  typedef std::tr1::unordered_map<StationKey, WifiRemoteStation *, StationKeyHash> StationIndex;
 
   StationStates m_states;
   Stations m_stations;
+  // the same states and stations, indexed by address and by (address, tid).
+  StationStateIndex m_stateIndex;
+  StationIndex m_stationIndex;
   /**
    * This is a pointer to the WifiPhy associated with this
    * WifiRemoteStationManager that is set on call to
@@ -23,18 +23,30 @@
 #include "adhoc-wifi-mac.h"
 #include "yans-wifi-phy.h"
 #include "arf-wifi-manager.h"
+#include "wifi-mac-header.h"
 #include "ns3/propagation-delay-model.h"
 #include "ns3/propagation-loss-model.h"
 #include "error-rate-model.h"
 #include "yans-error-rate-model.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/node.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 #include "ns3/object-factory.h"
 #include "dca-txop.h"
 #include "mac-rx-middle.h"
+#include "list-wifi-mac-queue.h"
+#include "indexed-wifi-mac-queue.h"
+#include "qos-blocked-destinations.h"
+#include "mixed-bias-delay-policy.h"
+#include "ns3/random-variable.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include <sstream>
+#include <stdlib.h>
 
 namespace ns3 {
 
@@ -188,6 +200,643 @@ public:
   }
 };
 
+//-----------------------------------------------------------------------------
+class YansWifiChannelRangeTest : public TestCase
+{
+public:
+  YansWifiChannelRangeTest ();
+
+  virtual bool DoRun (void);
+private:
+  Ptr<YansWifiPhy> CreatePhy (Ptr<MobilityModel> mobility, Ptr<YansWifiChannel> channel);
+  void Send (Ptr<YansWifiChannel> channel, Ptr<YansWifiPhy> sender);
+  void Receive (std::string context, Ptr<const Packet> packet);
+  bool RunOne (double maxRange);
+
+  std::vector<uint32_t> m_received;
+};
+
+YansWifiChannelRangeTest::YansWifiChannelRangeTest ()
+  : TestCase ("YansWifiChannel MaxRange")
+{}
+
+Ptr<YansWifiPhy>
+YansWifiChannelRangeTest::CreatePhy (Ptr<MobilityModel> mobility, Ptr<YansWifiChannel> channel)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  node->AggregateObject (mobility);
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  phy->SetChannel (channel);
+  phy->SetMobility (node);
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  std::ostringstream oss;
+  oss << m_received.size ();
+  phy->TraceConnect ("PhyRxBegin", oss.str (), MakeCallback (&YansWifiChannelRangeTest::Receive, this));
+  phy->TraceConnect ("PhyRxDrop", oss.str (), MakeCallback (&YansWifiChannelRangeTest::Receive, this));
+  m_received.push_back (0);
+  return phy;
+}
+
+void
+YansWifiChannelRangeTest::Send (Ptr<YansWifiChannel> channel, Ptr<YansWifiPhy> sender)
+{
+  channel->Send (sender, Create<Packet> (100), 16.0206, WifiPhy::GetOfdmRate6Mbps (), WIFI_PREAMBLE_LONG);
+}
+
+void
+YansWifiChannelRangeTest::Receive (std::string context, Ptr<const Packet> packet)
+{
+  m_received[atoi (context.c_str ())]++;
+}
+
+bool
+YansWifiChannelRangeTest::RunOne (double maxRange)
+{
+  m_received.clear ();
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  channel->SetPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+  channel->SetAttribute ("MaxRange", DoubleValue (maxRange));
+
+  Ptr<ConstantPositionMobilityModel> positions[4];
+  double x[4] = {0.0, 100.0, 250.0, 1000.0};
+  Ptr<YansWifiPhy> phys[5];
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      positions[i] = CreateObject<ConstantPositionMobilityModel> ();
+      positions[i]->SetPosition (Vector (x[i], 0.0, 0.0));
+      phys[i] = CreatePhy (positions[i], channel);
+    }
+  // moves towards the sender at 1000m/s from 5000m.
+  Ptr<ConstantVelocityMobilityModel> moving = CreateObject<ConstantVelocityMobilityModel> ();
+  moving->SetPosition (Vector (5000.0, 0.0, 0.0));
+  moving->SetVelocity (Vector (-1000.0, 0.0, 0.0));
+  phys[4] = CreatePhy (moving, channel);
+
+  Simulator::Schedule (Seconds (1.0), &YansWifiChannelRangeTest::Send, this, channel, phys[0]);
+  Simulator::Run ();
+  std::vector<uint32_t> first = m_received;
+  // the node at 1000m comes within range.
+  positions[3]->SetPosition (Vector (150.0, 0.0, 0.0));
+  Simulator::Schedule (Seconds (3.9), &YansWifiChannelRangeTest::Send, this, channel, phys[0]);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  uint32_t expectedFirst[5] = {0, 1, 1, 1, 1};
+  uint32_t expectedSecond[5] = {0, 1, 1, 1, 1};
+  if (maxRange != 0)
+    {
+      // at 1s, only the node at 100m is in range. At 4.9s, the nodes
+      // at 100m and 150m and the moving node, which is at 100m, are.
+      expectedFirst[2] = 0;
+      expectedFirst[3] = 0;
+      expectedFirst[4] = 0;
+      expectedSecond[2] = 0;
+    }
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (first[i], expectedFirst[i], "Unexpected reception of the first packet by " << i);
+      NS_TEST_EXPECT_MSG_EQ (m_received[i] - first[i], expectedSecond[i], "Unexpected reception of the second packet by " << i);
+    }
+  return GetErrorStatus ();
+}
+
+bool
+YansWifiChannelRangeTest::DoRun (void)
+{
+  RunOne (0.0);
+  RunOne (200.0);
+  return GetErrorStatus ();
+}
+
+//-----------------------------------------------------------------------------
+class YansWifiChannelSharedDeliveryTest : public TestCase
+{
+public:
+  YansWifiChannelSharedDeliveryTest ();
+
+  virtual bool DoRun (void);
+private:
+  void RunOnce (bool shared);
+  void Receive (Ptr<Packet> packet, double snr, WifiMode mode, enum WifiPreamble preamble);
+
+  std::vector<Ptr<Packet> > m_received;
+};
+
+YansWifiChannelSharedDeliveryTest::YansWifiChannelSharedDeliveryTest ()
+  : TestCase ("YansWifiChannel shared delivery")
+{}
+
+void
+YansWifiChannelSharedDeliveryTest::Receive (Ptr<Packet> packet, double snr, WifiMode mode, enum WifiPreamble preamble)
+{
+  m_received.push_back (packet);
+}
+
+void
+YansWifiChannelSharedDeliveryTest::RunOnce (bool shared)
+{
+  m_received.clear ();
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  channel->SetAttribute ("SharedDelivery", BooleanValue (shared));
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  channel->SetPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+
+  // the first PHY sends, the next two are close enough to receive
+  // successfully and the last two are too far away to sync.
+  double x[5] = {0.0, 5.0, 10.0, 10000.0, 20000.0};
+  Ptr<YansWifiPhy> phys[5];
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      Ptr<Node> node = CreateObject<Node> ();
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (x[i], 0.0, 0.0));
+      node->AggregateObject (mobility);
+      phys[i] = CreateObject<YansWifiPhy> ();
+      phys[i]->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+      phys[i]->SetChannel (channel);
+      phys[i]->SetMobility (node);
+      phys[i]->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+      phys[i]->SetReceiveOkCallback (MakeCallback (&YansWifiChannelSharedDeliveryTest::Receive, this));
+    }
+
+  Ptr<Packet> packet = Create<Packet> (100);
+  Simulator::Schedule (Seconds (1.0), &YansWifiChannel::Send, channel, phys[0], packet,
+                       16.0206, WifiPhy::GetOfdmRate6Mbps (), WIFI_PREAMBLE_LONG);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_received.size (), 2, "Unexpected number of successful receptions");
+  if (m_received.size () != 2)
+    {
+      return;
+    }
+  // shared: one copy shared by the 4 receivers and one copy for each
+  // of the successful receptions. Otherwise, one copy per receiver.
+  NS_TEST_EXPECT_MSG_EQ (channel->GetDeliveryCount (), 4, "Unexpected number of deliveries");
+  NS_TEST_EXPECT_MSG_EQ (channel->GetCopyCount (), shared ? 3 : 4, "Unexpected number of copies");
+
+  // the receivers and the sender can modify their packets independently.
+  NS_TEST_EXPECT_MSG_NE (m_received[0], m_received[1], "The receivers got the same packet");
+  NS_TEST_EXPECT_MSG_NE (m_received[0], packet, "The receiver got the packet of the sender");
+  m_received[0]->RemoveAtStart (10);
+  packet->RemoveAtStart (20);
+  NS_TEST_EXPECT_MSG_EQ (m_received[1]->GetSize (), 100, "The packet of a receiver was modified");
+}
+
+bool
+YansWifiChannelSharedDeliveryTest::DoRun (void)
+{
+  RunOnce (true);
+  RunOnce (false);
+  return GetErrorStatus ();
+}
+
+//-----------------------------------------------------------------------------
+class YansWifiChannelNumberTest : public TestCase
+{
+public:
+  YansWifiChannelNumberTest (double maxRange);
+
+  virtual bool DoRun (void);
+private:
+  void RecordDeliveries (Ptr<YansWifiChannel> channel);
+
+  double m_maxRange;
+  std::vector<uint64_t> m_deliveries;
+};
+
+YansWifiChannelNumberTest::YansWifiChannelNumberTest (double maxRange)
+  : TestCase (maxRange == 0 ?
+              "YansWifiChannel delivers only on the channel number of the sender" :
+              "YansWifiChannel delivers only on the channel number of the sender with a MaxRange"),
+    m_maxRange (maxRange)
+{}
+
+void
+YansWifiChannelNumberTest::RecordDeliveries (Ptr<YansWifiChannel> channel)
+{
+  m_deliveries.push_back (channel->GetDeliveryCount ());
+}
+
+bool
+YansWifiChannelNumberTest::DoRun (void)
+{
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  channel->SetPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+  channel->SetAttribute ("MaxRange", DoubleValue (m_maxRange));
+  m_deliveries.clear ();
+
+  // the first two PHYs start on channel 1, the last two on channel 2.
+  Ptr<YansWifiPhy> phys[4];
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      Ptr<Node> node = CreateObject<Node> ();
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (5.0 * i, 0.0, 0.0));
+      node->AggregateObject (mobility);
+      phys[i] = CreateObject<YansWifiPhy> ();
+      phys[i]->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+      phys[i]->SetChannel (channel);
+      phys[i]->SetMobility (node);
+      phys[i]->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+      phys[i]->SetChannelNumber (i < 2 ? 1 : 2);
+    }
+
+  Ptr<Packet> packet = Create<Packet> (100);
+  Simulator::Schedule (Seconds (1.0), &YansWifiChannel::Send, channel, phys[0], packet,
+                       16.0206, WifiPhy::GetOfdmRate6Mbps (), WIFI_PREAMBLE_LONG);
+  Simulator::Schedule (Seconds (1.5), &YansWifiChannelNumberTest::RecordDeliveries, this, channel);
+  // the second PHY leaves channel 1 and the last two join it.
+  Simulator::Schedule (Seconds (2.0), &YansWifiPhy::SetChannelNumber, phys[1], 3);
+  Simulator::Schedule (Seconds (2.0), &YansWifiPhy::SetChannelNumber, phys[3], 1);
+  Simulator::Schedule (Seconds (2.0), &YansWifiPhy::SetChannelNumber, phys[2], 1);
+  Simulator::Schedule (Seconds (3.0), &YansWifiChannel::Send, channel, phys[0], packet,
+                       16.0206, WifiPhy::GetOfdmRate6Mbps (), WIFI_PREAMBLE_LONG);
+  Simulator::Schedule (Seconds (3.5), &YansWifiChannelNumberTest::RecordDeliveries, this, channel);
+  Simulator::Schedule (Seconds (4.0), &YansWifiChannel::Send, channel, phys[1], packet,
+                       16.0206, WifiPhy::GetOfdmRate6Mbps (), WIFI_PREAMBLE_LONG);
+  Simulator::Schedule (Seconds (4.5), &YansWifiChannelNumberTest::RecordDeliveries, this, channel);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_deliveries.size (), 3, "Unexpected number of records");
+  NS_TEST_EXPECT_MSG_EQ (m_deliveries[0], 1, "Unexpected number of deliveries before the switch");
+  NS_TEST_EXPECT_MSG_EQ (m_deliveries[1], 3, "Unexpected number of deliveries after the switch");
+  NS_TEST_EXPECT_MSG_EQ (m_deliveries[2], 3, "Unexpected delivery on channel 3");
+  NS_TEST_EXPECT_MSG_EQ (phys[2]->GetChannelNumber (), 1, "Unexpected channel number");
+
+  return GetErrorStatus ();
+}
+
+//-----------------------------------------------------------------------------
+class WifiRemoteStationManagerStressTest : public TestCase
+{
+public:
+  WifiRemoteStationManagerStressTest ();
+
+  virtual bool DoRun (void);
+private:
+  bool RunOne (std::string type);
+};
+
+WifiRemoteStationManagerStressTest::WifiRemoteStationManagerStressTest ()
+  : TestCase ("WifiRemoteStationManager with many stations")
+{}
+
+bool
+WifiRemoteStationManagerStressTest::RunOne (std::string type)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (type);
+  Ptr<WifiRemoteStationManager> manager = factory.Create<WifiRemoteStationManager> ();
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  manager->SetupPhy (phy);
+
+  WifiMacHeader data;
+  data.SetType (WIFI_MAC_DATA);
+  WifiMacHeader qos;
+  qos.SetType (WIFI_MAC_QOSDATA);
+  qos.SetQosTid (3);
+  Ptr<Packet> packet = Create<Packet> (1000);
+
+  const uint32_t nStations = 500;
+  std::vector<Mac48Address> addresses;
+  for (uint32_t i = 0; i < nStations; i++)
+    {
+      addresses.push_back (Mac48Address::Allocate ());
+    }
+  for (uint32_t i = 0; i < nStations; i++)
+    {
+      manager->PrepareForQueue (addresses[i], &data, packet, 1000);
+      manager->GetDataMode (addresses[i], &data, packet, 1000);
+      manager->PrepareForQueue (addresses[i], &qos, packet, 1000);
+      manager->GetDataMode (addresses[i], &qos, packet, 1000);
+      if (i % 2 == 1)
+        {
+          manager->RecordGotAssocTxOk (addresses[i]);
+        }
+      if (i % 3 == 0)
+        {
+          // exhaust the RTS retries of the QoS station only.
+          for (uint32_t j = 0; j < manager->GetMaxSsrc (); j++)
+            {
+              manager->ReportRtsFailed (addresses[i], &qos);
+            }
+        }
+    }
+  for (uint32_t i = 0; i < nStations; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (manager->IsAssociated (addresses[i]), (i % 2 == 1),
+                             type << ": wrong state for station " << i);
+      NS_TEST_ASSERT_MSG_EQ (manager->NeedRtsRetransmission (addresses[i], &data, packet), true,
+                             type << ": wrong non-QoS station " << i);
+      NS_TEST_ASSERT_MSG_EQ (manager->NeedRtsRetransmission (addresses[i], &qos, packet), (i % 3 != 0),
+                             type << ": wrong QoS station " << i);
+    }
+  manager->Dispose ();
+  phy->Dispose ();
+  return false;
+}
+
+bool
+WifiRemoteStationManagerStressTest::DoRun (void)
+{
+  const char *types[] = {
+    "ns3::ArfWifiManager",
+    "ns3::AarfWifiManager",
+    "ns3::AarfcdWifiManager",
+    "ns3::AmrrWifiManager",
+    "ns3::CaraWifiManager",
+    "ns3::ConstantRateWifiManager",
+    "ns3::IdealWifiManager",
+    "ns3::MinstrelWifiManager",
+    "ns3::OnoeWifiManager",
+    "ns3::RraaWifiManager"
+  };
+  for (uint32_t i = 0; i < sizeof (types) / sizeof (types[0]); i++)
+    {
+      if (RunOne (types[i]))
+        {
+          return true;
+        }
+    }
+  return GetErrorStatus ();
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Apply the same random operations to a ListWifiMacQueue and an
+ * IndexedWifiMacQueue, a few of them at a time over simulated time so
+ * that packets expire, and check that they return the same packets.
+ */
+class WifiMacQueueTest : public TestCase
+{
+public:
+  WifiMacQueueTest ();
+
+  virtual bool DoRun (void);
+private:
+  void Step (void);
+  void Check (Ptr<const Packet> a, const WifiMacHeader &hdrA,
+              Ptr<const Packet> b, const WifiMacHeader &hdrB, std::string op);
+
+  Ptr<WifiMacQueue> m_list;
+  Ptr<WifiMacQueue> m_indexed;
+  QosBlockedDestinations m_blocked;
+  std::vector<Mac48Address> m_addresses;
+  std::vector<Ptr<const Packet> > m_packets;
+  UniformVariable m_random;
+  uint16_t m_sequence;
+  uint32_t m_steps;
+};
+
+WifiMacQueueTest::WifiMacQueueTest ()
+  : TestCase ("WifiMacQueue implementations"),
+    m_sequence (0),
+    m_steps (0)
+{}
+
+void
+WifiMacQueueTest::Check (Ptr<const Packet> a, const WifiMacHeader &hdrA,
+                         Ptr<const Packet> b, const WifiMacHeader &hdrB, std::string op)
+{
+  NS_TEST_EXPECT_MSG_EQ (a, b, op << " at step " << m_steps << ": different packets");
+  if (a != 0 && b != 0)
+    {
+      NS_TEST_EXPECT_MSG_EQ (hdrA.GetSequenceNumber (), hdrB.GetSequenceNumber (),
+                             op << " at step " << m_steps << ": different headers");
+    }
+}
+
+void
+WifiMacQueueTest::Step (void)
+{
+  WifiMacHeader hdrA;
+  WifiMacHeader hdrB;
+  Time tstampA;
+  Time tstampB;
+  for (uint32_t i = 0; i < 10 && !GetErrorStatus (); i++, m_steps++)
+    {
+      Mac48Address address = m_addresses[m_random.GetInteger (0, m_addresses.size () - 1)];
+      uint8_t tid = m_random.GetInteger (0, 3);
+      WifiMacHeader::AddressType type = m_random.GetValue () < 0.8 ? WifiMacHeader::ADDR1 : WifiMacHeader::ADDR2;
+      switch (m_random.GetInteger (0, 11))
+        {
+        case 0:
+        case 1:
+        case 2:
+        case 3:
+          {
+            WifiMacHeader hdr;
+            hdr.SetType (m_random.GetValue () < 0.8 ? WIFI_MAC_QOSDATA : WIFI_MAC_DATA);
+            if (hdr.IsQosData ())
+              {
+                hdr.SetQosTid (tid);
+              }
+            hdr.SetAddr1 (address);
+            hdr.SetAddr2 (m_addresses[m_random.GetInteger (0, m_addresses.size () - 1)]);
+            hdr.SetSequenceNumber (m_sequence++);
+            Ptr<const Packet> packet = Create<Packet> (100);
+            m_packets.push_back (packet);
+            if (m_random.GetValue () < 0.9)
+              {
+                m_list->Enqueue (packet, hdr);
+                m_indexed->Enqueue (packet, hdr);
+              }
+            else
+              {
+                m_list->PushFront (packet, hdr);
+                m_indexed->PushFront (packet, hdr);
+              }
+          }
+          break;
+        case 4:
+          Check (m_list->Dequeue (&hdrA), hdrA, m_indexed->Dequeue (&hdrB), hdrB, "Dequeue");
+          break;
+        case 5:
+          Check (m_list->Peek (&hdrA), hdrA, m_indexed->Peek (&hdrB), hdrB, "Peek");
+          break;
+        case 6:
+          Check (m_list->DequeueByTidAndAddress (&hdrA, tid, type, address), hdrA,
+                 m_indexed->DequeueByTidAndAddress (&hdrB, tid, type, address), hdrB,
+                 "DequeueByTidAndAddress");
+          break;
+        case 7:
+          {
+            // as EdcaTxopN does when it aggregates MSDUs.
+            Ptr<const Packet> a = m_list->PeekByTidAndAddress (&hdrA, tid, type, address);
+            Ptr<const Packet> b = m_indexed->PeekByTidAndAddress (&hdrB, tid, type, address);
+            Check (a, hdrA, b, hdrB, "PeekByTidAndAddress");
+            if (a != 0)
+              {
+                NS_TEST_EXPECT_MSG_EQ (m_list->Remove (a), m_indexed->Remove (a),
+                                       "Remove at step " << m_steps);
+              }
+          }
+          break;
+        case 8:
+          NS_TEST_EXPECT_MSG_EQ (m_list->GetNPacketsByTidAndAddress (tid, type, address),
+                                 m_indexed->GetNPacketsByTidAndAddress (tid, type, address),
+                                 "GetNPacketsByTidAndAddress at step " << m_steps);
+          break;
+        case 9:
+          Check (m_list->DequeueFirstAvailable (&hdrA, tstampA, &m_blocked), hdrA,
+                 m_indexed->DequeueFirstAvailable (&hdrB, tstampB, &m_blocked), hdrB,
+                 "DequeueFirstAvailable");
+          NS_TEST_EXPECT_MSG_EQ (tstampA, tstampB, "DequeueFirstAvailable at step " << m_steps);
+          break;
+        case 10:
+          Check (m_list->PeekFirstAvailable (&hdrA, tstampA, &m_blocked), hdrA,
+                 m_indexed->PeekFirstAvailable (&hdrB, tstampB, &m_blocked), hdrB,
+                 "PeekFirstAvailable");
+          NS_TEST_EXPECT_MSG_EQ (tstampA, tstampB, "PeekFirstAvailable at step " << m_steps);
+          break;
+        case 11:
+          if (!m_packets.empty ())
+            {
+              Ptr<const Packet> packet = m_packets[m_random.GetInteger (0, m_packets.size () - 1)];
+              NS_TEST_EXPECT_MSG_EQ (m_list->Remove (packet), m_indexed->Remove (packet),
+                                     "Remove at step " << m_steps);
+            }
+          break;
+        }
+      NS_TEST_EXPECT_MSG_EQ (m_list->IsEmpty (), m_indexed->IsEmpty (), "IsEmpty at step " << m_steps);
+      NS_TEST_EXPECT_MSG_EQ (m_list->GetSize (), m_indexed->GetSize (), "GetSize at step " << m_steps);
+    }
+  if (m_packets.size () > 1000)
+    {
+      m_packets.clear ();
+    }
+}
+
+bool
+WifiMacQueueTest::DoRun (void)
+{
+  m_list = CreateObject<ListWifiMacQueue> ();
+  m_indexed = CreateObject<IndexedWifiMacQueue> ();
+  m_list->SetMaxSize (100);
+  m_indexed->SetMaxSize (100);
+  m_list->SetMaxDelay (MilliSeconds (300));
+  m_indexed->SetMaxDelay (MilliSeconds (300));
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      m_addresses.push_back (Mac48Address::Allocate ());
+    }
+  m_blocked.Block (m_addresses[0], 1);
+  m_blocked.Block (m_addresses[1], 2);
+
+  for (uint32_t i = 0; i < 5000; i++)
+    {
+      Simulator::Schedule (MilliSeconds (i), &WifiMacQueueTest::Step, this);
+    }
+  // the packets which are still queued expire.
+  Simulator::Schedule (Seconds (6.0), &WifiMacQueueTest::Step, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_EQ (m_steps, 5001 * 10, "Not all the steps were run");
+
+  m_list = 0;
+  m_indexed = 0;
+  m_packets.clear ();
+  return GetErrorStatus ();
+}
+
+//-----------------------------------------------------------------------------
+
+class WifiMacQueueDelayPolicyTest : public TestCase
+{
+public:
+  WifiMacQueueDelayPolicyTest ();
+
+  virtual bool DoRun (void);
+private:
+  static uint32_t GetManyHops (const WifiMacHeader &hdr);
+  uint32_t CountDelayed (Ptr<WifiMacQueueDelayPolicy> policy, uint32_t hops, uint32_t n);
+};
+
+WifiMacQueueDelayPolicyTest::WifiMacQueueDelayPolicyTest ()
+  : TestCase ("WifiMacQueue delay policies")
+{}
+
+uint32_t
+WifiMacQueueDelayPolicyTest::GetManyHops (const WifiMacHeader &hdr)
+{
+  return 1000;
+}
+
+uint32_t
+WifiMacQueueDelayPolicyTest::CountDelayed (Ptr<WifiMacQueueDelayPolicy> policy, uint32_t hops, uint32_t n)
+{
+  Ptr<const Packet> packet = Create<Packet> (100);
+  WifiMacHeader hdr;
+  hdr.SetTypeData ();
+  uint32_t delayed = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      if (policy->GetDelay (packet, hdr, hops).IsStrictlyPositive ())
+        {
+          delayed++;
+        }
+    }
+  return delayed;
+}
+
+bool
+WifiMacQueueDelayPolicyTest::DoRun (void)
+{
+  Ptr<MixedBiasDelayPolicy> mb = CreateObject<MixedBiasDelayPolicy> ();
+  NS_TEST_EXPECT_MSG_EQ (CountDelayed (mb, 0, 1000), 0, "Packets delayed with an unknown number of hops");
+  // R is 0.95 at one hop and 5 * (0.5 / 100 + 0.5 / 100000) at ten hops.
+  uint32_t delayed = CountDelayed (mb, 1, 10000);
+  NS_TEST_EXPECT_MSG_EQ_TOL (delayed, 500, 150, "Wrong share of packets delayed at one hop");
+  delayed = CountDelayed (mb, 10, 10000);
+  NS_TEST_EXPECT_MSG_EQ_TOL (delayed, 9750, 150, "Wrong share of packets delayed at ten hops");
+
+  // the packets are delayed in the queue only when it knows their number of hops.
+  Ptr<WifiMacQueue> queue = CreateObject<IndexedWifiMacQueue> ();
+  ObjectFactory factory;
+  factory.SetTypeId (MixedBiasDelayPolicy::GetTypeId ());
+  factory.Set ("Alpha", DoubleValue (0.0));
+  factory.Set ("Beta2", DoubleValue (50.0));
+  factory.Set ("Delay", TimeValue (MilliSeconds (20)));
+  queue->SetAttribute ("DelayPolicy", ObjectFactoryValue (factory));
+  WifiMacHeader hdr;
+  hdr.SetTypeData ();
+  hdr.SetAddr1 (Mac48Address::Allocate ());
+  Time tstamp;
+  queue->Enqueue (Create<Packet> (100), hdr);
+  queue->DequeueFirstAvailable (&hdr, tstamp, 0);
+  NS_TEST_EXPECT_MSG_EQ (tstamp, Seconds (0), "Packet delayed without a number of hops");
+  queue->SetHopCountCallback (MakeCallback (&WifiMacQueueDelayPolicyTest::GetManyHops));
+  queue->Enqueue (Create<Packet> (100), hdr);
+  queue->DequeueFirstAvailable (&hdr, tstamp, 0);
+  NS_TEST_EXPECT_MSG_EQ (tstamp, MilliSeconds (20), "Packet not delayed");
+  queue->Dispose ();
+
+  // the adaptive policy moves every MovePeriod + 1 delayed packets.
+  Ptr<AdaptiveMixedBiasDelayPolicy> amb = CreateObject<AdaptiveMixedBiasDelayPolicy> ();
+  amb->SetAttribute ("MovePeriod", UintegerValue (5));
+  amb->NotifyRxStats (10, 0, Seconds (1.0));
+  NS_TEST_EXPECT_MSG_EQ (CountDelayed (amb, 1000, 5), 5, "Packets not delayed");
+  NS_TEST_EXPECT_MSG_EQ (amb->GetAlpha (), 0.5, "Moved too early");
+  NS_TEST_EXPECT_MSG_EQ (amb->GetBeta1 (), 2.0, "Moved too early");
+  NS_TEST_EXPECT_MSG_EQ (amb->GetBeta2 (), 5.0, "Moved too early");
+  CountDelayed (amb, 1000, 1);
+  NS_TEST_EXPECT_MSG_EQ ((amb->GetAlpha () != 0.5 || amb->GetBeta1 () != 2.0 || amb->GetBeta2 () != 5.0), true,
+                         "Did not move");
+  NS_TEST_EXPECT_MSG_EQ (amb->GetBestAlpha (), 0.5, "The first solution is the best one");
+  NS_TEST_EXPECT_MSG_EQ (amb->GetBestBeta1 (), 2.0, "The first solution is the best one");
+  NS_TEST_EXPECT_MSG_EQ (amb->GetBestBeta2 (), 5.0, "The first solution is the best one");
+
+  Simulator::Destroy ();
+  return GetErrorStatus ();
+}
+
 //-----------------------------------------------------------------------------
 
 class WifiTestSuite : public TestSuite
@@ -201,6 +850,13 @@ WifiTestSuite::WifiTestSuite ()
 {
   AddTestCase (new WifiTest);
   AddTestCase (new MacRxMiddleTest);
+  AddTestCase (new YansWifiChannelRangeTest);
+  AddTestCase (new YansWifiChannelSharedDeliveryTest);
+  AddTestCase (new YansWifiChannelNumberTest (0.0));
+  AddTestCase (new YansWifiChannelNumberTest (100.0));
+  AddTestCase (new WifiRemoteStationManagerStressTest);
+  AddTestCase (new WifiMacQueueTest);
+  AddTestCase (new WifiMacQueueDelayPolicyTest);
 }
 
 WifiTestSuite g_wifiTestSuite;
@@ -24,11 +24,15 @@
 #include "ns3/node.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/object-factory.h"
 #include "yans-wifi-channel.h"
 #include "yans-wifi-phy.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/propagation-delay-model.h"
+#include <algorithm>
+#include <math.h>
 
 NS_LOG_COMPONENT_DEFINE ("YansWifiChannel");
 
@@ -50,16 +54,42 @@ YansWifiChannel::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&YansWifiChannel::m_delay),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("MaxRange",
+                   "The distance, in meters, beyond which a transmission is not delivered "
+                   "to the receivers. If zero, it is delivered to all the receivers.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&YansWifiChannel::SetMaxRange,
+                                       &YansWifiChannel::GetMaxRange),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("SharedDelivery",
+                   "If true, all the receivers of a transmission share a single copy of the "
+                   "packet and copy it only when they forward it to their MAC. If false, "
+                   "each receiver is handed its own copy.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&YansWifiChannel::m_sharedDelivery),
+                   MakeBooleanChecker ())
     ;
   return tid;
 }
 
 YansWifiChannel::YansWifiChannel ()
+  : m_maxRange (0.0),
+    m_sharedDelivery (true),
+    m_nIndexed (0),
+    m_deliveries (0),
+    m_copies (0)
 {}
 YansWifiChannel::~YansWifiChannel ()
 {
   NS_LOG_FUNCTION_NOARGS ();
+  for (Sites::const_iterator i = m_sites.begin (); i != m_sites.end (); i++)
+    {
+      i->mobility->TraceDisconnectWithoutContext ("CourseChange",
+                                                  MakeCallback (&YansWifiChannel::CourseChanged, this));
+    }
+  m_sites.clear ();
   m_phyList.clear ();
+  m_channelPhys.clear ();
 }
 
 void 
@@ -73,51 +103,248 @@ YansWifiChannel::SetPropagationDelayModel (Ptr<PropagationDelayModel> delay)
   m_delay = delay;
 }
 
+void
+YansWifiChannel::SetMaxRange (double range)
+{
+  NS_ASSERT (range >= 0);
+  m_maxRange = range;
+  if (m_maxRange == 0)
+    {
+      return;
+    }
+  // the size of the cells changed.
+  m_grid.clear ();
+  m_movingSites.clear ();
+  for (uint32_t i = 0; i < m_sites.size (); i++)
+    {
+      PlaceSite (i);
+    }
+}
+
+double
+YansWifiChannel::GetMaxRange (void) const
+{
+  return m_maxRange;
+}
+
+YansWifiChannel::Cell
+YansWifiChannel::GetCell (const Vector &position) const
+{
+  return Cell ((int32_t) floor (position.x / m_maxRange),
+               (int32_t) floor (position.y / m_maxRange));
+}
+
+void
+YansWifiChannel::PlaceSite (uint32_t site) const
+{
+  struct Site *s = &m_sites[site];
+  if (!s->moving)
+    {
+      Grid::iterator i = m_grid.find (s->cell);
+      if (i != m_grid.end ())
+        {
+          std::vector<uint32_t>::iterator j = std::find (i->second.begin (), i->second.end (), site);
+          if (j != i->second.end ())
+            {
+              i->second.erase (j);
+            }
+          if (i->second.empty ())
+            {
+              m_grid.erase (i);
+            }
+        }
+    }
+  Vector velocity = s->mobility->GetVelocity ();
+  s->moving = velocity.x != 0 || velocity.y != 0 || velocity.z != 0;
+  if (s->moving)
+    {
+      // the position of a moving site changes without any
+      // notification: it is checked on every transmission.
+      m_movingSites.insert (site);
+    }
+  else
+    {
+      m_movingSites.erase (site);
+      s->cell = GetCell (s->mobility->GetPosition ());
+      m_grid[s->cell].push_back (site);
+    }
+}
+
+void
+YansWifiChannel::CourseChanged (Ptr<const MobilityModel> mobility) const
+{
+  std::map<const MobilityModel *, uint32_t>::const_iterator i = m_siteIndex.find (PeekPointer (mobility));
+  if (i != m_siteIndex.end () && m_maxRange != 0)
+    {
+      PlaceSite (i->second);
+    }
+}
+
+void
+YansWifiChannel::IndexPhys (void) const
+{
+  for (; m_nIndexed < m_phyList.size (); m_nIndexed++)
+    {
+      Ptr<MobilityModel> mobility = m_phyList[m_nIndexed]->GetMobility ()->GetObject<MobilityModel> ();
+      NS_ASSERT (mobility != 0);
+      uint16_t channelNumber = m_phyList[m_nIndexed]->GetChannelNumber ();
+      std::map<const MobilityModel *, uint32_t>::const_iterator i = m_siteIndex.find (PeekPointer (mobility));
+      if (i != m_siteIndex.end ())
+        {
+          m_sites[i->second].phys[channelNumber].push_back (m_nIndexed);
+          continue;
+        }
+      struct Site site;
+      site.mobility = mobility;
+      site.phys[channelNumber].push_back (m_nIndexed);
+      site.moving = true;
+      m_siteIndex[PeekPointer (mobility)] = m_sites.size ();
+      m_sites.push_back (site);
+      PlaceSite (m_sites.size () - 1);
+      mobility->TraceConnectWithoutContext ("CourseChange",
+                                            MakeCallback (&YansWifiChannel::CourseChanged, this));
+    }
+}
+
 void 
 YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double txPowerDbm,
                        WifiMode wifiMode, WifiPreamble preamble) const
 {
   Ptr<MobilityModel> senderMobility = sender->GetMobility ()->GetObject<MobilityModel> ();
   NS_ASSERT (senderMobility != 0);
-  uint32_t j = 0;
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++, j++)
-    { 
-      if (sender != (*i))
+  if (m_sharedDelivery)
+    {
+      // the sender might modify its packet after this call returns so
+      // the receivers share a single copy of it, which nobody modifies.
+      packet = packet->Copy ();
+      m_copies++;
+    }
+  if (m_maxRange == 0)
+    {
+      // For now don't account for inter channel interference
+      ChannelPhys::const_iterator c = m_channelPhys.find (sender->GetChannelNumber ());
+      if (c == m_channelPhys.end ())
+        {
+          return;
+        }
+      for (std::vector<uint32_t>::const_iterator j = c->second.begin (); j != c->second.end (); j++)
         {
-          // For now don't account for inter channel interference
-          if ((*i)->GetChannelNumber() != sender->GetChannelNumber())
-              continue;
-          
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
-          Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
-          double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
-          NS_LOG_DEBUG ("propagation: txPower="<<txPowerDbm<<"dbm, rxPower="<<rxPowerDbm<<"dbm, "<<
-                        "distance="<<senderMobility->GetDistanceFrom (receiverMobility)<<"m, delay="<<delay);
-          Ptr<Packet> copy = packet->Copy ();
-          Ptr<Object> dstNetDevice = m_phyList[j]->GetDevice ();
-          uint32_t dstNode;
-          if (dstNetDevice == 0)
+          Ptr<YansWifiPhy> receiver = m_phyList[*j];
+          if (sender != receiver)
             {
-              dstNode = 0xffffffff;
+              Ptr<MobilityModel> receiverMobility = receiver->GetMobility ()->GetObject<MobilityModel> ();
+              SendTo (*j, senderMobility, receiverMobility, packet, txPowerDbm, wifiMode, preamble);
             }
-          else
+        }
+      return;
+    }
+
+  IndexPhys ();
+  // the sites in range are collected first so that the receivers are
+  // visited in the same order as without the index.
+  uint16_t channelNumber = sender->GetChannelNumber ();
+  std::vector<std::pair<uint32_t, uint32_t> > receivers;
+  Vector position = senderMobility->GetPosition ();
+  Cell cell = GetCell (position);
+  std::vector<uint32_t> candidates (m_movingSites.begin (), m_movingSites.end ());
+  for (int32_t x = cell.first - 1; x <= cell.first + 1; x++)
+    {
+      for (int32_t y = cell.second - 1; y <= cell.second + 1; y++)
+        {
+          Grid::const_iterator i = m_grid.find (Cell (x, y));
+          if (i != m_grid.end ())
             {
-              dstNode = dstNetDevice->GetObject<NetDevice> ()->GetNode ()->GetId ();
+              candidates.insert (candidates.end (), i->second.begin (), i->second.end ());
             }
-          Simulator::ScheduleWithContext (dstNode,
-                                          delay, &YansWifiChannel::Receive, this, 
-                                          j, copy, rxPowerDbm, wifiMode, preamble);
         }
     }
+  for (std::vector<uint32_t>::const_iterator i = candidates.begin (); i != candidates.end (); i++)
+    {
+      const struct Site &site = m_sites[*i];
+      ChannelPhys::const_iterator c = site.phys.find (channelNumber);
+      if (c == site.phys.end ()
+          || CalculateDistance (position, site.mobility->GetPosition ()) > m_maxRange)
+        {
+          continue;
+        }
+      for (std::vector<uint32_t>::const_iterator j = c->second.begin (); j != c->second.end (); j++)
+        {
+          receivers.push_back (std::make_pair (*j, *i));
+        }
+    }
+  std::sort (receivers.begin (), receivers.end ());
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator i = receivers.begin (); i != receivers.end (); i++)
+    {
+      Ptr<YansWifiPhy> receiver = m_phyList[i->first];
+      if (sender != receiver)
+        {
+          SendTo (i->first, senderMobility, m_sites[i->second].mobility,
+                  packet, txPowerDbm, wifiMode, preamble);
+        }
+    }
+}
+
+void
+YansWifiChannel::SendTo (uint32_t j, Ptr<MobilityModel> senderMobility,
+                         Ptr<MobilityModel> receiverMobility, Ptr<const Packet> packet,
+                         double txPowerDbm, WifiMode wifiMode, WifiPreamble preamble) const
+{
+  Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
+  double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
+  NS_LOG_DEBUG ("propagation: txPower="<<txPowerDbm<<"dbm, rxPower="<<rxPowerDbm<<"dbm, "<<
+                "distance="<<senderMobility->GetDistanceFrom (receiverMobility)<<"m, delay="<<delay);
+  m_deliveries++;
+  if (!m_sharedDelivery)
+    {
+      packet = packet->Copy ();
+      m_copies++;
+    }
+  Ptr<Object> dstNetDevice = m_phyList[j]->GetDevice ();
+  uint32_t dstNode;
+  if (dstNetDevice == 0)
+    {
+      dstNode = 0xffffffff;
+    }
+  else
+    {
+      dstNode = dstNetDevice->GetObject<NetDevice> ()->GetNode ()->GetId ();
+    }
+  Simulator::ScheduleWithContext (dstNode,
+                                  delay, &YansWifiChannel::Receive, this, 
+                                  j, packet, rxPowerDbm, wifiMode, preamble);
 }
 
 void
-YansWifiChannel::Receive (uint32_t i, Ptr<Packet> packet, double rxPowerDbm,
+YansWifiChannel::Receive (uint32_t i, Ptr<const Packet> packet, double rxPowerDbm,
                           WifiMode txMode, WifiPreamble preamble) const
 {
   m_phyList[i]->StartReceivePacket (packet, rxPowerDbm, txMode, preamble);
 }
 
+Ptr<Packet>
+YansWifiChannel::CopyReceivedPacket (Ptr<const Packet> packet) const
+{
+  if (!m_sharedDelivery)
+    {
+      // the receiver was handed its own copy
+      return ConstCast<Packet> (packet);
+    }
+  m_copies++;
+  return packet->Copy ();
+}
+
+uint64_t
+YansWifiChannel::GetDeliveryCount (void) const
+{
+  return m_deliveries;
+}
+
+uint64_t
+YansWifiChannel::GetCopyCount (void) const
+{
+  return m_copies;
+}
+
 uint32_t 
 YansWifiChannel::GetNDevices (void) const
 {
@@ -133,6 +360,53 @@ void
 YansWifiChannel::Add (Ptr<YansWifiPhy> phy)
 {
   m_phyList.push_back (phy);
+  m_channelPhys[phy->GetChannelNumber ()].push_back (m_phyList.size () - 1);
+}
+
+void
+YansWifiChannel::NotifyChannelNumberChanged (Ptr<YansWifiPhy> phy, uint16_t oldChannelNumber)
+{
+  uint16_t channelNumber = phy->GetChannelNumber ();
+  if (channelNumber == oldChannelNumber)
+    {
+      return;
+    }
+  ChannelPhys::const_iterator c = m_channelPhys.find (oldChannelNumber);
+  NS_ASSERT (c != m_channelPhys.end ());
+  std::vector<uint32_t>::const_iterator j = c->second.begin ();
+  while (j != c->second.end () && m_phyList[*j] != phy)
+    {
+      j++;
+    }
+  NS_ASSERT (j != c->second.end ());
+  uint32_t index = *j;
+  MovePhy (m_channelPhys, index, oldChannelNumber, channelNumber);
+  if (index < m_nIndexed)
+    {
+      Ptr<MobilityModel> mobility = phy->GetMobility ()->GetObject<MobilityModel> ();
+      std::map<const MobilityModel *, uint32_t>::const_iterator i = m_siteIndex.find (PeekPointer (mobility));
+      NS_ASSERT (i != m_siteIndex.end ());
+      MovePhy (m_sites[i->second].phys, index, oldChannelNumber, channelNumber);
+    }
+  NS_LOG_DEBUG ("phy " << index << " moved from channel " << oldChannelNumber << " to " << channelNumber);
+}
+
+void
+YansWifiChannel::MovePhy (ChannelPhys &channelPhys, uint32_t index,
+                          uint16_t oldChannelNumber, uint16_t channelNumber)
+{
+  ChannelPhys::iterator c = channelPhys.find (oldChannelNumber);
+  NS_ASSERT (c != channelPhys.end ());
+  std::vector<uint32_t>::iterator j = std::find (c->second.begin (), c->second.end (), index);
+  NS_ASSERT (j != c->second.end ());
+  c->second.erase (j);
+  if (c->second.empty ())
+    {
+      channelPhys.erase (c);
+    }
+  // keep the receivers in the order in which they were added.
+  std::vector<uint32_t> &phys = channelPhys[channelNumber];
+  phys.insert (std::lower_bound (phys.begin (), phys.end (), index), index);
 }
 
 } // namespace ns3
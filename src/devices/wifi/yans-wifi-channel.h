@@ -21,8 +21,11 @@
 #define YANS_WIFI_CHANNEL_H
 
 #include <vector>
+#include <map>
+#include <set>
 #include <stdint.h>
 #include "ns3/packet.h"
+#include "ns3/vector.h"
 #include "wifi-channel.h"
 #include "wifi-mode.h"
 #include "wifi-preamble.h"
@@ -32,6 +35,7 @@ namespace ns3 {
 class NetDevice;
 class PropagationLossModel;
 class PropagationDelayModel;
+class MobilityModel;
 class YansWifiPhy;
 
 /**
@@ -44,6 +48,31 @@ class YansWifiPhy;
  * class and contains a ns3::PropagationLossModel and a ns3::PropagationDelayModel.
  * By default, no propagation models are set so, it is the caller's responsability
  * to set them before using the channel.
+ *
+ * By default, every transmission is delivered to every other PHY on the
+ * same channel number, even to those which are too far away to sense
+ * it. The PHYs are kept in one list per channel number so that only
+ * those on the channel number of the sender are visited. If the
+ * MaxRange attribute is set, the PHYs are stored in a grid of
+ * MaxRange-sized cells and a transmission is delivered only to the
+ * PHYs which are within MaxRange of the sender: only the 9 cells around
+ * the sender are visited. Within a cell, the PHYs of each node are
+ * also kept in one list per channel number. The position of a PHY in
+ * the grid is updated whenever its mobility model reports a course
+ * change and the PHYs which move at a non-zero velocity are checked on
+ * every transmission.
+ * The transmissions from beyond MaxRange are not accounted as
+ * interference either, so MaxRange should be chosen large enough for
+ * the sum of their received powers to be negligible against the noise
+ * floor of the PHYs.
+ *
+ * By default, all the receivers of a transmission are handed the same
+ * read-only copy of the packet: a receiver makes its own copy only
+ * when it needs to modify the packet, that is, when it forwards a
+ * successfully received packet to its MAC (see CopyReceivedPacket).
+ * The packets which are dropped or received in error are never
+ * copied. If the SharedDelivery attribute is false, each receiver is
+ * handed its own copy instead.
  */
 class YansWifiChannel : public WifiChannel
 {
@@ -58,6 +87,15 @@ public:
   virtual Ptr<NetDevice> GetDevice (uint32_t i) const;
 
   void Add (Ptr<YansWifiPhy> phy);
+  /**
+   * \param phy a PHY attached to this channel.
+   * \param oldChannelNumber the channel number of the PHY until now.
+   *
+   * This method should not be invoked by normal users. It is
+   * currently invoked only from YansWifiPhy::SetChannelNumber, to
+   * move the PHY to the list of its new channel number.
+   */
+  void NotifyChannelNumberChanged (Ptr<YansWifiPhy> phy, uint16_t oldChannelNumber);
 
   /**
    * \param loss the new propagation loss model.
@@ -67,6 +105,17 @@ public:
    * \param delay the new propagation delay model.
    */
   void SetPropagationDelayModel (Ptr<PropagationDelayModel> delay);
+  /**
+   * \param range the distance, in meters, beyond which a transmission
+   *        is not delivered. If zero, transmissions are delivered to all
+   *        the PHYs attached to this channel.
+   */
+  void SetMaxRange (double range);
+  /**
+   * \returns the distance, in meters, beyond which a transmission is
+   *          not delivered, or zero.
+   */
+  double GetMaxRange (void) const;
 
   /**
    * \param sender the device from which the packet is originating.
@@ -82,16 +131,78 @@ public:
    */
   void Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double txPowerDbm,
              WifiMode wifiMode, WifiPreamble preamble) const;
+  /**
+   * \param packet a packet delivered by this channel.
+   * \returns a copy of the packet which the caller can modify.
+   *
+   * This method should not be invoked by normal users. It is
+   * currently invoked only from YansWifiPhy, when a packet is
+   * forwarded to the MAC.
+   */
+  Ptr<Packet> CopyReceivedPacket (Ptr<const Packet> packet) const;
+  /**
+   * \returns the number of packets delivered to the PHYs since the
+   *          creation of this channel, including those which were
+   *          dropped by the PHYs.
+   */
+  uint64_t GetDeliveryCount (void) const;
+  /**
+   * \returns the number of packet copies made for the deliveries
+   *          since the creation of this channel. The difference with
+   *          GetDeliveryCount is the number of copies which were avoided
+   *          by sharing the packets between the receivers.
+   */
+  uint64_t GetCopyCount (void) const;
 
 private:
   typedef std::vector<Ptr<YansWifiPhy> > PhyList;
-  void Receive (uint32_t i, Ptr<Packet> packet, double rxPowerDbm,
-                WifiMode txMode, WifiPreamble preamble) const;
+  // the indexes in m_phyList of the PHYs on each channel number, sorted.
+  typedef std::map<uint16_t, std::vector<uint32_t> > ChannelPhys;
+  typedef std::pair<int32_t, int32_t> Cell;
+  typedef std::map<Cell, std::vector<uint32_t> > Grid;
+  /**
+   * The PHYs which share a mobility model, that is, the PHYs of
+   * the same node, by channel number.
+   */
+  struct Site
+  {
+    Ptr<MobilityModel> mobility;
+    ChannelPhys phys;
+    Cell cell;
+    bool moving;
+  };
+  typedef std::vector<struct Site> Sites;
 
+  void Receive (uint32_t i, Ptr<const Packet> packet, double rxPowerDbm,
+                WifiMode txMode, WifiPreamble preamble) const;
+  void SendTo (uint32_t j, Ptr<MobilityModel> senderMobility,
+               Ptr<MobilityModel> receiverMobility, Ptr<const Packet> packet,
+               double txPowerDbm, WifiMode wifiMode, WifiPreamble preamble) const;
+  static void MovePhy (ChannelPhys &channelPhys, uint32_t index,
+                       uint16_t oldChannelNumber, uint16_t channelNumber);
+  void IndexPhys (void) const;
+  void PlaceSite (uint32_t site) const;
+  void CourseChanged (Ptr<const MobilityModel> mobility) const;
+  Cell GetCell (const Vector &position) const;
 
   PhyList m_phyList;
+  ChannelPhys m_channelPhys;
   Ptr<PropagationLossModel> m_loss;
   Ptr<PropagationDelayModel> m_delay;
+  double m_maxRange;
+  bool m_sharedDelivery;
+  // the spatial index, used only when m_maxRange is not zero. It is
+  // built lazily because the mobility models are often aggregated to
+  // the nodes after the PHYs are added to the channel: the PHYs before
+  // m_nIndexed have been indexed.
+  mutable uint32_t m_nIndexed;
+  mutable Sites m_sites;
+  mutable std::map<const MobilityModel *, uint32_t> m_siteIndex;
+  // the sites which are not moving, by cell
+  mutable Grid m_grid;
+  mutable std::set<uint32_t> m_movingSites;
+  mutable uint64_t m_deliveries;
+  mutable uint64_t m_copies;
 };
 
 } // namespace ns3
@@ -146,6 +146,7 @@ YansWifiPhy::DoDispose (void)
   NS_LOG_FUNCTION (this);
   m_channel = 0;
   m_deviceRateSet.clear ();
+  m_txDurationForms.clear ();
   m_device = 0;
   m_mobility = 0;
   m_state = 0;
@@ -181,6 +182,26 @@ YansWifiPhy::ConfigureStandard (enum WifiPhyStandard standard)
     NS_ASSERT (false);
     break;
   }
+  ConfigureTxDurations ();
+}
+
+void
+YansWifiPhy::ConfigureTxDurations (void)
+{
+  m_txDurationForms.clear ();
+  for (WifiModeList::const_iterator i = m_deviceRateSet.begin (); i != m_deviceRateSet.end (); i++)
+    {
+      uint32_t index = 2 * i->GetUid ();
+      if (index + 2 > m_txDurationForms.size ())
+        {
+          struct InterferenceHelper::TxDurationForm none = {0, 0, 0, 0};
+          m_txDurationForms.resize (index + 2, none);
+        }
+      m_txDurationForms[index + WIFI_PREAMBLE_LONG] =
+        InterferenceHelper::GetTxDurationForm (*i, WIFI_PREAMBLE_LONG);
+      m_txDurationForms[index + WIFI_PREAMBLE_SHORT] =
+        InterferenceHelper::GetTxDurationForm (*i, WIFI_PREAMBLE_SHORT);
+    }
 }
 
 
@@ -327,7 +348,7 @@ YansWifiPhy::SetChannelNumber (uint16_t nch)
     {
       // this is not channel switch, this is initialization 
       NS_LOG_DEBUG("start at channel " << nch);
-      m_channelNumber = nch;
+      DoSetChannelNumber (nch);
       return;
     }
 
@@ -365,7 +386,18 @@ YansWifiPhy::SetChannelNumber (uint16_t nch)
    * state are added to the event list and are employed later to figure
    * out the state of the medium after the switching.
    */
+  DoSetChannelNumber (nch);
+}
+
+void
+YansWifiPhy::DoSetChannelNumber (uint16_t nch)
+{
+  uint16_t oldChannelNumber = m_channelNumber;
   m_channelNumber = nch;
+  if (m_channel != 0)
+    {
+      m_channel->NotifyChannelNumberChanged (this, oldChannelNumber);
+    }
 }
 
 uint16_t 
@@ -391,7 +423,7 @@ YansWifiPhy::SetReceiveErrorCallback (RxErrorCallback callback)
   m_state->SetReceiveErrorCallback (callback);
 }
 void 
-YansWifiPhy::StartReceivePacket (Ptr<Packet> packet, 
+YansWifiPhy::StartReceivePacket (Ptr<const Packet> packet, 
                                  double rxPowerDbm,
                                  WifiMode txMode,
                                  enum WifiPreamble preamble)
@@ -694,6 +726,11 @@ YansWifiPhy::GetLastRxStartTime (void) const
 Time 
 YansWifiPhy::CalculateTxDuration (uint32_t size, WifiMode payloadMode, enum WifiPreamble preamble) const
 {
+  uint32_t index = 2 * payloadMode.GetUid () + preamble;
+  if (index < m_txDurationForms.size () && m_txDurationForms[index].symbolUs != 0)
+    {
+      return InterferenceHelper::CalculateTxDuration (size, m_txDurationForms[index]);
+    }
   return m_interference.CalculateTxDuration (size, payloadMode, preamble);
 }
 
@@ -748,7 +785,7 @@ YansWifiPhy::GetPowerDbm (uint8_t power) const
 }
 
 void
-YansWifiPhy::EndReceive (Ptr<Packet> packet, Ptr<InterferenceHelper::Event> event)
+YansWifiPhy::EndReceive (Ptr<const Packet> packet, Ptr<InterferenceHelper::Event> event)
 {
   NS_LOG_FUNCTION (this << packet << event);
   NS_ASSERT (IsStateRx ());
@@ -768,7 +805,9 @@ YansWifiPhy::EndReceive (Ptr<Packet> packet, Ptr<InterferenceHelper::Event> even
       double signalDbm = RatioToDb (event->GetRxPowerW ()) + 30;
       double noiseDbm = RatioToDb(event->GetRxPowerW() / snrPer.snr) - GetRxNoiseFigure() + 30 ;
       NotifyPromiscSniffRx (packet, (uint16_t)GetChannelFrequencyMhz (), GetChannelNumber (), dataRate500KbpsUnits, isShortPreamble, signalDbm, noiseDbm);
-      m_state->SwitchFromRxEndOk (packet, snrPer.snr, event->GetPayloadMode (), event->GetPreambleType ());
+      // the packet is shared with the other receivers of the
+      // transmission and the MAC modifies it.
+      m_state->SwitchFromRxEndOk (m_channel->CopyReceivedPacket (packet), snrPer.snr, event->GetPayloadMode (), event->GetPreambleType ());
     } 
   else 
     {
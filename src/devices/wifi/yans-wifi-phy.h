@@ -91,7 +91,7 @@ public:
   /// Return current center channel frequency in MHz, see SetChannelNumber()
   double GetChannelFrequencyMhz() const;
   
-  void StartReceivePacket (Ptr<Packet> packet,
+  void StartReceivePacket (Ptr<const Packet> packet,
                            double rxPowerDbm,
                            WifiMode mode,
                            WifiPreamble preamble);
@@ -152,13 +152,15 @@ private:
   void ConfigureHolland (void);
   void Configure80211p_CCH (void);
   void Configure80211p_SCH (void);
+  void ConfigureTxDurations (void);
   double GetEdThresholdW (void) const;
   double DbmToW (double dbm) const;
   double DbToRatio (double db) const;
   double WToDbm (double w) const;
   double RatioToDb (double ratio) const;
   double GetPowerDbm (uint8_t power) const;
-  void EndReceive (Ptr<Packet> packet, Ptr<InterferenceHelper::Event> event);
+  void EndReceive (Ptr<const Packet> packet, Ptr<InterferenceHelper::Event> event);
+  void DoSetChannelNumber (uint16_t nch);
 
 private:
   double   m_edThresholdW;
@@ -211,6 +213,12 @@ private:
    * mandatory rates".
    */
   WifiModeList m_deviceRateSet;
+  /**
+   * The closed forms of CalculateTxDuration for the modes of
+   * m_deviceRateSet, indexed by 2 * WifiMode::GetUid () + preamble.
+   * The other entries have a null symbolUs.
+   */
+  std::vector<struct InterferenceHelper::TxDurationForm> m_txDurationForms;
 
   EventId m_endRxEvent;
   UniformVariable m_random;
@@ -23,6 +23,9 @@
 #include "ns3/mesh-point-device.h"
 #include "ns3/wifi-net-device.h"
 #include "ns3/mesh-wifi-interface-mac.h"
+#include "ns3/mixed-bias-delay-policy.h"
+#include "ns3/udp-server.h"
+#include <set>
 namespace ns3
 {
 MeshHelper::MeshHelper () :
@@ -85,6 +88,8 @@ MeshHelper::Install (const WifiPhyHelper &phyHelper, NodeContainer c) const
       // Create a mesh point device
       Ptr<MeshPointDevice> mp = CreateObject<MeshPointDevice> ();
       node->AddDevice (mp);
+      // All the queues of the mesh point share the delay policy of the first one
+      Ptr<WifiMacQueueDelayPolicy> policy = 0;
       // Create wifi interfaces (single interface by default)
       for (uint32_t i = 0; i < m_nInterfaces; ++i)
         {
@@ -98,6 +103,12 @@ MeshHelper::Install (const WifiPhyHelper &phyHelper, NodeContainer c) const
               channel = i * 5;
             }
           Ptr<WifiNetDevice> iface = CreateInterface (phyHelper, node, channel);
+          Ptr<MeshWifiInterfaceMac> mac = iface->GetMac ()->GetObject<MeshWifiInterfaceMac> ();
+          if (policy == 0)
+            {
+              policy = mac->GetDelayPolicies ().front ();
+            }
+          mac->SetDelayPolicy (policy);
           mp->AddInterface (iface);
         }
       if (!m_stack->InstallStack (mp))
@@ -207,5 +218,35 @@ MeshHelper::ResetStats (const ns3::Ptr<ns3::NetDevice>& device)
   NS_ASSERT (mp != 0);
   m_stack->ResetStats (mp);
 }
+uint32_t
+MeshHelper::ConnectRxStats (Ptr<UdpServer> server, NetDeviceContainer devices)
+{
+  std::set<Ptr<AdaptiveMixedBiasDelayPolicy> > connected;
+  for (NetDeviceContainer::Iterator i = devices.Begin (); i != devices.End (); ++i)
+    {
+      Ptr<MeshPointDevice> mp = (*i)->GetObject<MeshPointDevice> ();
+      NS_ASSERT (mp != 0);
+      std::vector<Ptr<NetDevice> > ifaces = mp->GetInterfaces ();
+      for (std::vector<Ptr<NetDevice> >::const_iterator j = ifaces.begin (); j != ifaces.end (); ++j)
+        {
+          Ptr<WifiNetDevice> device = (*j)->GetObject<WifiNetDevice> ();
+          NS_ASSERT (device != 0);
+          Ptr<MeshWifiInterfaceMac> mac = device->GetMac ()->GetObject<MeshWifiInterfaceMac> ();
+          NS_ASSERT (mac != 0);
+          std::vector<Ptr<WifiMacQueueDelayPolicy> > policies = mac->GetDelayPolicies ();
+          for (std::vector<Ptr<WifiMacQueueDelayPolicy> >::const_iterator k = policies.begin (); k != policies.end (); ++k)
+            {
+              Ptr<AdaptiveMixedBiasDelayPolicy> policy = DynamicCast<AdaptiveMixedBiasDelayPolicy> (*k);
+              if (policy != 0 && connected.find (policy) == connected.end ())
+                {
+                  server->TraceConnectWithoutContext ("RxStats",
+                      MakeCallback (&AdaptiveMixedBiasDelayPolicy::NotifyRxStats, policy));
+                  connected.insert (policy);
+                }
+            }
+        }
+    }
+  return connected.size ();
+}
 } //namespace ns3
 
@@ -29,6 +29,7 @@
 namespace ns3 {
 
 class WifiChannel;
+class UdpServer;
 
 /** 
  * \ingroup dot11s
@@ -145,6 +146,9 @@ public:
   /** 
    * \brief Install 802.11s mesh device & protocols on given node list
    * 
+   * All the queues of a mesh point, over its interfaces and access
+   * classes, share one delay policy.
+   * 
    * \param phyHelper           Wifi PHY helper
    * \param c               List of nodes to install
    * 
@@ -190,6 +194,21 @@ public:
    * \brief Reset statistics.
    */
   void ResetStats (const ns3::Ptr<ns3::NetDevice>&);
+
+  /**
+   * \brief Feed the "RxStats" of a UDP server to the adaptive delay policies of the devices.
+   *
+   * Connects AdaptiveMixedBiasDelayPolicy::NotifyRxStats of each policy of
+   * the queues of the given mesh point devices to the server, so that the
+   * policies can measure the utility of their solutions. A policy shared
+   * by several queues, as Install does for the queues of a mesh point, is
+   * connected once.
+   *
+   * \param server is the UDP server which receives the traffic of the mesh
+   * \param devices is the list of mesh point devices
+   * \return the number of adaptive delay policies connected
+   */
+  static uint32_t ConnectRxStats (Ptr<UdpServer> server, NetDeviceContainer devices);
 private:
   /**
    * \internal
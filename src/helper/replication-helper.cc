@@ -0,0 +1,38 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "replication-helper.h"
+#include "ns3/replication-runner.h"
+#include "ns3/nstime.h"
+#include <limits>
+
+namespace ns3 {
+
+void
+ReplicationHelper::RecordUdpServer (Ptr<UdpServer> server, std::string prefix)
+{
+  double received = server->GetReceived ();
+  double lost = server->GetLost ();
+  double nan = std::numeric_limits<double>::quiet_NaN ();
+  ReplicationRunner::Record (prefix + "received", received);
+  ReplicationRunner::Record (prefix + "lost", lost);
+  // always record a value such that the results of all the
+  // replications stay aligned with their run.
+  ReplicationRunner::Record (prefix + "pdr", (received + lost > 0) ? received / (received + lost) : nan);
+  ReplicationRunner::Record (prefix + "delay", (received > 0) ? server->GetTotalDelay ().GetSeconds () / received : nan);
+}
+
+} // namespace ns3
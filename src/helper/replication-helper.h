@@ -0,0 +1,49 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef REPLICATION_HELPER_H
+#define REPLICATION_HELPER_H
+
+#include "ns3/ptr.h"
+#include "ns3/udp-server.h"
+#include <string>
+
+namespace ns3 {
+
+/**
+ * \brief record the results of common applications in a replication
+ *        run by a ReplicationRunner
+ */
+class ReplicationHelper
+{
+public:
+  /**
+   * \param server the server whose statistics are recorded
+   * \param prefix the prefix of the names under which they are recorded
+   *
+   * Record the number of packets received and lost by the server
+   * under the names "<prefix>received" and "<prefix>lost", its packet
+   * delivery ratio under "<prefix>pdr" and the mean delay of the
+   * received packets, in seconds, under "<prefix>delay". The delay is
+   * NaN if the server did not receive any packet and the delivery
+   * ratio is NaN if no packet was sent to it: a value is recorded
+   * in every replication.
+   */
+  static void RecordUdpServer (Ptr<UdpServer> server, std::string prefix = "");
+};
+
+} // namespace ns3
+
+#endif /* REPLICATION_HELPER_H */
@@ -277,4 +277,16 @@ std::istream& operator>> (std::istream& is, Mac48Address & address)
 }
 
 
+size_t Mac48AddressHash::operator()(Mac48Address const &x) const
+{
+  uint8_t buffer[6];
+  x.CopyTo (buffer);
+  size_t hash = 0;
+  for (uint8_t i = 0; i < 6; i++)
+    {
+      hash = hash * 31 + buffer[i];
+    }
+  return hash;
+}
+
 } // namespace ns3
@@ -164,6 +164,11 @@ inline bool operator < (const Mac48Address &a, const Mac48Address &b)
 std::ostream& operator<< (std::ostream& os, const Mac48Address & address);
 std::istream& operator>> (std::istream& is, Mac48Address & address);
 
+class Mac48AddressHash : public std::unary_function<Mac48Address, size_t> {
+public:
+  size_t operator()(Mac48Address const &x) const;
+};
+
 } // namespace ns3
 
 #endif /* MAC48_ADDRESS_H */
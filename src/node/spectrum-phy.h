@@ -101,6 +101,11 @@ public:
    * waveform. The units of the PSD are the same specified for SpectrumChannel::StartTx().
    * @param st spectrum type
    * @param duration the duration of the incoming waveform
+   *
+   * The same PacketBurst is delivered to all the receivers of a
+   * waveform: the receivers must not modify it, nor the packets it
+   * contains, and must copy a packet before handing it over to a
+   * layer which might modify it.
    */
   virtual void StartRx (Ptr<PacketBurst> p, Ptr <const SpectrumValue> rxPsd, SpectrumType st, Time duration) = 0;
   
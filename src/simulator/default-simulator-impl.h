@@ -24,10 +24,15 @@
 #include "simulator-impl.h"
 #include "scheduler.h"
 #include "event-impl.h"
+#include "event-profiler.h"
 
 #include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
 
 #include <list>
+#include <string>
+#include <vector>
+#include <fstream>
 
 namespace ns3 {
 
@@ -59,16 +64,45 @@ public:
   virtual void SetScheduler (ObjectFactory schedulerFactory);
   virtual uint32_t GetSystemId (void) const; 
   virtual uint32_t GetContext (void) const;
+  virtual struct Statistics GetStatistics (void) const;
+
+  /**
+   * \returns the number of events which were cancelled but which are
+   *          still stored in the event list.
+   *
+   * When the scheduler is indexed (see Scheduler::IsIndexed), Cancel
+   * removes the events from the event list right away and this number
+   * stays close to zero: only the cancelled events which share the
+   * timestamp of the current event are left behind. Otherwise, the
+   * cancelled events are dropped only when they expire.
+   */
+  uint32_t GetDeadEventCount (void) const;
 
 private:
   virtual void DoDispose (void);
   void ProcessOneEvent (void);
+  void FillBatch (void);
+  void FlushBatch (void);
+  bool IsBatchEmpty (void) const;
   uint64_t NextTs (void) const;
+  void PrintProfile (void) const;
+  void SetStatisticsInterval (Time interval);
+  Time GetStatisticsInterval (void) const;
+  void SampleStatistics (void);
   typedef std::list<EventId> DestroyEvents;
+  typedef std::vector<Scheduler::Event> EventBatch;
 
   DestroyEvents m_destroyEvents;
   bool m_stop;
   Ptr<Scheduler> m_events;
+  // the events which share the timestamp of the event being
+  // processed and which were detached from m_events in a single
+  // batch. Events before m_batchPos have already been processed.
+  EventBatch m_batch;
+  uint32_t m_batchPos;
+  // when false, m_batch is not used: the events are detached from
+  // m_events one by one.
+  bool m_batchDispatch;
   uint32_t m_uid;
   uint32_t m_currentUid;
   uint64_t m_currentTs;
@@ -76,6 +110,29 @@ private:
   // number of events that have been inserted but not yet scheduled,
   // not counting the "destroy" events; this is used for validation
   int m_unscheduledEvents;
+  // number of cancelled events still present in m_events or m_batch
+  uint32_t m_deadEvents;
+  // the event counters reported by GetStatistics
+  uint64_t m_scheduledEvents;
+  uint64_t m_processedEvents;
+  uint64_t m_cancelledEvents;
+  uint32_t m_peakEvents;
+  // wall-clock time spent in the previous calls to Run and start
+  // of the current one, in nanoseconds.
+  uint64_t m_runWallClock;
+  uint64_t m_runStart;
+  // the statistics are sampled by the first event which expires at
+  // or after m_nextStatisticsTs.
+  uint64_t m_statisticsInterval;
+  uint64_t m_nextStatisticsTs;
+  std::string m_statisticsOutput;
+  std::ofstream *m_statisticsStream;
+  struct Statistics m_lastStatistics;
+  TracedCallback<const Statistics &> m_statisticsTrace;
+  // when true, the events are timed and accounted in m_profiler.
+  bool m_profiling;
+  std::string m_profilingOutput;
+  EventProfiler m_profiler;
 };
 
 } // namespace ns3
@@ -0,0 +1,456 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-allocator.h"
+#include "ns3/simulator-config.h"
+#include "ns3/core-config.h"
+#include "ns3/assert.h"
+#include <new>
+#include <string.h>
+#include <stdlib.h>
+
+#if defined (HAVE_THREAD_LOCAL_STORAGE) && defined (HAVE_PTHREAD_H)
+#define EVENT_ALLOCATOR_POOLS 1
+#include <pthread.h>
+#endif
+
+namespace ns3 {
+
+// the granularity of the size classes.
+static const size_t EVENT_ALLOCATOR_ALIGN = 16;
+// the number of size classes: blocks of up to 16*8=128 bytes
+// are served from the pools.
+static const uint32_t EVENT_ALLOCATOR_N_CLASSES = 8;
+// the size of the slabs obtained from the system. The slabs are
+// aligned on their size such that the header of the slab of a block
+// is found by masking the address of the block.
+static const size_t EVENT_ALLOCATOR_SLAB_SIZE = 16384;
+
+#ifdef EVENT_ALLOCATOR_POOLS
+
+namespace {
+
+struct Block
+{
+  Block *next;
+};
+
+struct Pool;
+
+struct SlabHeader
+{
+  Pool *owner;
+  uint32_t sizeClass;
+};
+
+// the blocks of a slab start after its header.
+static const size_t EVENT_ALLOCATOR_HEADER_SIZE =
+  ((sizeof (SlabHeader) + EVENT_ALLOCATOR_ALIGN - 1) / EVENT_ALLOCATOR_ALIGN) * EVENT_ALLOCATOR_ALIGN;
+
+// the large blocks are preceded by the pool which allocated them.
+struct LargeHeader
+{
+  Pool *owner;
+};
+static const size_t EVENT_ALLOCATOR_LARGE_HEADER_SIZE =
+  ((sizeof (LargeHeader) + EVENT_ALLOCATOR_ALIGN - 1) / EVENT_ALLOCATOR_ALIGN) * EVENT_ALLOCATOR_ALIGN;
+
+struct Pool
+{
+  Block *freeList[EVENT_ALLOCATOR_N_CLASSES];
+  // the blocks of this pool freed by other threads: pushed by the
+  // other threads with a compare-and-swap, taken all at once by the
+  // owner of the pool.
+  Block * volatile remoteFree;
+  // the number of large blocks of this pool freed by other threads.
+  volatile int64_t remoteLargeFrees;
+  EventAllocator::Stats stats;
+  // the next pool in the list of the pools of the exited threads.
+  Pool *nextOrphan;
+};
+
+static __thread Pool *g_pool = 0;
+
+// the pools of the threads which have exited, adopted by the next
+// threads which allocate events. They cannot be released because
+// some of their blocks may still be in use.
+static Pool *g_orphans = 0;
+static pthread_mutex_t g_orphansMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t g_poolKey;
+static pthread_once_t g_poolKeyOnce = PTHREAD_ONCE_INIT;
+
+void
+OrphanPool (void *p)
+{
+  Pool *pool = static_cast<Pool *> (p);
+  pthread_mutex_lock (&g_orphansMutex);
+  pool->nextOrphan = g_orphans;
+  g_orphans = pool;
+  pthread_mutex_unlock (&g_orphansMutex);
+}
+
+void
+CreatePoolKey (void)
+{
+  pthread_key_create (&g_poolKey, &OrphanPool);
+}
+
+Pool *
+GetPool (void)
+{
+  if (g_pool == 0)
+    {
+      pthread_once (&g_poolKeyOnce, &CreatePoolKey);
+      pthread_mutex_lock (&g_orphansMutex);
+      Pool *pool = g_orphans;
+      if (pool != 0)
+        {
+          g_orphans = pool->nextOrphan;
+        }
+      pthread_mutex_unlock (&g_orphansMutex);
+      if (pool == 0)
+        {
+          pool = new Pool;
+          memset (pool, 0, sizeof (Pool));
+        }
+      pool->nextOrphan = 0;
+      g_pool = pool;
+      // the pool is orphaned when the thread exits.
+      pthread_setspecific (g_poolKey, pool);
+    }
+  return g_pool;
+}
+
+SlabHeader *
+GetSlab (void *buffer)
+{
+  uintptr_t address = reinterpret_cast<uintptr_t> (buffer);
+  return reinterpret_cast<SlabHeader *> (address & ~(uintptr_t)(EVENT_ALLOCATOR_SLAB_SIZE - 1));
+}
+
+void
+DrainRemoteFrees (Pool *pool)
+{
+  Block *block = __sync_lock_test_and_set (&pool->remoteFree, (Block *)0);
+  while (block != 0)
+    {
+      Block *next = block->next;
+      uint32_t sizeClass = GetSlab (block)->sizeClass;
+      block->next = pool->freeList[sizeClass];
+      pool->freeList[sizeClass] = block;
+      pool->stats.deallocations++;
+      pool->stats.live--;
+      block = next;
+    }
+  if (pool->remoteLargeFrees != 0)
+    {
+      int64_t n = __sync_lock_test_and_set (&pool->remoteLargeFrees, 0);
+      pool->stats.deallocations += n;
+      pool->stats.live -= n;
+    }
+}
+
+void
+RefillPool (Pool *pool, uint32_t sizeClass)
+{
+  size_t blockSize = (sizeClass + 1) * EVENT_ALLOCATOR_ALIGN;
+  uint32_t n = (EVENT_ALLOCATOR_SLAB_SIZE - EVENT_ALLOCATOR_HEADER_SIZE) / blockSize;
+  void *memory;
+  if (posix_memalign (&memory, EVENT_ALLOCATOR_SLAB_SIZE, EVENT_ALLOCATOR_SLAB_SIZE) != 0)
+    {
+      throw std::bad_alloc ();
+    }
+  uint8_t *slab = static_cast<uint8_t *> (memory);
+  SlabHeader *header = reinterpret_cast<SlabHeader *> (slab);
+  header->owner = pool;
+  header->sizeClass = sizeClass;
+  pool->stats.slabs++;
+  Block *head = pool->freeList[sizeClass];
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Block *block = reinterpret_cast<Block *> (slab + EVENT_ALLOCATOR_HEADER_SIZE + i * blockSize);
+      block->next = head;
+      head = block;
+    }
+  pool->freeList[sizeClass] = head;
+}
+
+} // anonymous namespace
+
+#endif /* EVENT_ALLOCATOR_POOLS */
+
+void *
+EventAllocator::Allocate (size_t size)
+{
+#ifdef EVENT_ALLOCATOR_POOLS
+  Pool *pool = GetPool ();
+  if (pool->remoteFree != 0 || pool->remoteLargeFrees != 0)
+    {
+      DrainRemoteFrees (pool);
+    }
+  pool->stats.allocations++;
+  pool->stats.live++;
+  if (pool->stats.live > pool->stats.peak)
+    {
+      pool->stats.peak = pool->stats.live;
+    }
+  uint32_t sizeClass = (size - 1) / EVENT_ALLOCATOR_ALIGN;
+  if (size == 0 || sizeClass >= EVENT_ALLOCATOR_N_CLASSES)
+    {
+      pool->stats.largeAllocations++;
+      uint8_t *buffer = static_cast<uint8_t *> (::operator new (EVENT_ALLOCATOR_LARGE_HEADER_SIZE + size));
+      reinterpret_cast<LargeHeader *> (buffer)->owner = pool;
+      return buffer + EVENT_ALLOCATOR_LARGE_HEADER_SIZE;
+    }
+  if (pool->freeList[sizeClass] == 0)
+    {
+      RefillPool (pool, sizeClass);
+    }
+  Block *block = pool->freeList[sizeClass];
+  pool->freeList[sizeClass] = block->next;
+  return block;
+#else
+  return ::operator new (size);
+#endif
+}
+
+void
+EventAllocator::Deallocate (void *buffer, size_t size)
+{
+  if (buffer == 0)
+    {
+      return;
+    }
+#ifdef EVENT_ALLOCATOR_POOLS
+  // the pool of the calling thread, if it has one.
+  Pool *pool = g_pool;
+  uint32_t sizeClass = (size - 1) / EVENT_ALLOCATOR_ALIGN;
+  if (size == 0 || sizeClass >= EVENT_ALLOCATOR_N_CLASSES)
+    {
+      uint8_t *start = static_cast<uint8_t *> (buffer) - EVENT_ALLOCATOR_LARGE_HEADER_SIZE;
+      Pool *owner = reinterpret_cast<LargeHeader *> (start)->owner;
+      ::operator delete (start);
+      if (owner == pool)
+        {
+          pool->stats.deallocations++;
+          pool->stats.live--;
+        }
+      else
+        {
+          __sync_fetch_and_add (&owner->remoteLargeFrees, 1);
+        }
+      return;
+    }
+  Block *block = static_cast<Block *> (buffer);
+  SlabHeader *slab = GetSlab (buffer);
+  NS_ASSERT (slab->sizeClass == sizeClass);
+  Pool *owner = slab->owner;
+  if (owner == pool)
+    {
+      pool->stats.deallocations++;
+      pool->stats.live--;
+      block->next = pool->freeList[sizeClass];
+      pool->freeList[sizeClass] = block;
+      return;
+    }
+  // the block goes back to the pool which allocated it.
+  Block *head;
+  do
+    {
+      head = owner->remoteFree;
+      block->next = head;
+    }
+  while (!__sync_bool_compare_and_swap (&owner->remoteFree, head, block));
+#else
+  ::operator delete (buffer);
+#endif
+}
+
+EventAllocator::Stats
+EventAllocator::GetStats (void)
+{
+#ifdef EVENT_ALLOCATOR_POOLS
+  Pool *pool = GetPool ();
+  DrainRemoteFrees (pool);
+  return pool->stats;
+#else
+  Stats stats;
+  memset (&stats, 0, sizeof (stats));
+  return stats;
+#endif
+}
+
+void
+EventAllocator::ResetPeak (void)
+{
+#ifdef EVENT_ALLOCATOR_POOLS
+  Pool *pool = GetPool ();
+  DrainRemoteFrees (pool);
+  pool->stats.peak = pool->stats.live;
+#endif
+}
+
+} // namespace ns3
+
+#include "ns3/test.h"
+#include "ns3/system-thread.h"
+#include "make-event.h"
+#include "event-impl.h"
+#include <vector>
+#include <algorithm>
+
+namespace ns3 {
+
+class EventAllocatorTestCase : public TestCase
+{
+public:
+  EventAllocatorTestCase ();
+  void Target (uint32_t a, double b) {}
+private:
+  virtual bool DoRun (void);
+};
+
+EventAllocatorTestCase::EventAllocatorTestCase ()
+  : TestCase ("Check that events are recycled by the event allocator")
+{}
+
+bool
+EventAllocatorTestCase::DoRun (void)
+{
+#ifdef EVENT_ALLOCATOR_POOLS
+  EventAllocator::Stats before = EventAllocator::GetStats ();
+  EventImpl *a = MakeEvent (&EventAllocatorTestCase::Target, this, 1, 2.0);
+  EventImpl *b = MakeEvent (&EventAllocatorTestCase::Target, this, 3, 4.0);
+  EventAllocator::Stats during = EventAllocator::GetStats ();
+  NS_TEST_EXPECT_MSG_EQ (during.allocations - before.allocations, 2, "Unexpected number of allocations");
+  NS_TEST_EXPECT_MSG_EQ (during.live - before.live, 2, "Unexpected number of live events");
+  NS_TEST_EXPECT_MSG_EQ ((during.peak >= during.live), true, "Peak is smaller than the number of live events");
+
+  b->Unref ();
+  EventImpl *c = MakeEvent (&EventAllocatorTestCase::Target, this, 5, 6.0);
+  NS_TEST_EXPECT_MSG_EQ (c, b, "The last freed block was not reused");
+  a->Unref ();
+  c->Unref ();
+
+  EventAllocator::Stats after = EventAllocator::GetStats ();
+  NS_TEST_EXPECT_MSG_EQ (after.live, before.live, "Events leaked from the allocator");
+  NS_TEST_EXPECT_MSG_EQ (after.deallocations - before.deallocations, 3, "Unexpected number of deallocations");
+
+  void *large = EventAllocator::Allocate (1024);
+  EventAllocator::Deallocate (large, 1024);
+  NS_TEST_EXPECT_MSG_EQ (EventAllocator::GetStats ().largeAllocations - after.largeAllocations, 1,
+                         "Large blocks must not be served from the pools");
+#endif
+  return false;
+}
+
+class EventAllocatorThreadTestCase : public TestCase
+{
+public:
+  EventAllocatorThreadTestCase ();
+  void Target (uint32_t a, double b) {}
+private:
+  virtual bool DoRun (void);
+  void FreeEvents (void);
+  void AllocateEvent (void);
+  void GetPoolStats (void);
+
+  std::vector<EventImpl *> m_events;
+  EventAllocator::Stats m_stats;
+};
+
+EventAllocatorThreadTestCase::EventAllocatorThreadTestCase ()
+  : TestCase ("Check that events freed by another thread return to the pool which allocated them")
+{}
+
+void
+EventAllocatorThreadTestCase::FreeEvents (void)
+{
+  EventAllocator::Stats before = EventAllocator::GetStats ();
+  for (std::vector<EventImpl *>::iterator i = m_events.begin (); i != m_events.end (); i++)
+    {
+      (*i)->Unref ();
+    }
+  m_stats = EventAllocator::GetStats ();
+  m_stats.live -= before.live;
+  m_stats.deallocations -= before.deallocations;
+}
+
+void
+EventAllocatorThreadTestCase::AllocateEvent (void)
+{
+  m_events.push_back (MakeEvent (&EventAllocatorThreadTestCase::Target, this, 1, 2.0));
+}
+
+void
+EventAllocatorThreadTestCase::GetPoolStats (void)
+{
+  m_stats = EventAllocator::GetStats ();
+}
+
+bool
+EventAllocatorThreadTestCase::DoRun (void)
+{
+#ifdef EVENT_ALLOCATOR_POOLS
+  // allocated by this thread, freed by another one
+  EventAllocator::Stats before = EventAllocator::GetStats ();
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      m_events.push_back (MakeEvent (&EventAllocatorThreadTestCase::Target, this, i, 2.0));
+    }
+  Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&EventAllocatorThreadTestCase::FreeEvents, this));
+  thread->Start ();
+  thread->Join ();
+  NS_TEST_EXPECT_MSG_EQ (m_stats.live, 0, "The freeing thread must not account the blocks of another thread");
+  NS_TEST_EXPECT_MSG_EQ (m_stats.deallocations, 0, "The freeing thread must not keep the blocks of another thread");
+  EventAllocator::Stats after = EventAllocator::GetStats ();
+  NS_TEST_EXPECT_MSG_EQ (after.live, before.live, "The blocks were not returned to the allocating thread");
+  NS_TEST_EXPECT_MSG_EQ (after.deallocations - before.deallocations, 1000, "Unexpected number of deallocations");
+  EventImpl *reused = MakeEvent (&EventAllocatorThreadTestCase::Target, this, 1, 2.0);
+  NS_TEST_EXPECT_MSG_EQ ((std::find (m_events.begin (), m_events.end (), reused) != m_events.end ()), true,
+                         "The blocks freed by another thread were not reused");
+  reused->Unref ();
+  NS_TEST_EXPECT_MSG_EQ (EventAllocator::GetStats ().slabs, after.slabs, "No slab must be needed to reuse the blocks");
+  m_events.clear ();
+
+  // allocated by a thread which exits before the event is freed
+  thread = Create<SystemThread> (MakeCallback (&EventAllocatorThreadTestCase::AllocateEvent, this));
+  thread->Start ();
+  thread->Join ();
+  m_events[0]->Unref ();
+  m_events.clear ();
+  // the next thread adopts the pool of the exited one
+  thread = Create<SystemThread> (MakeCallback (&EventAllocatorThreadTestCase::GetPoolStats, this));
+  thread->Start ();
+  thread->Join ();
+  NS_TEST_EXPECT_MSG_EQ ((m_stats.slabs > 0), true, "The pool of an exited thread was not reused");
+  NS_TEST_EXPECT_MSG_EQ (m_stats.live, 0, "The pool of an exited thread leaked a block");
+#endif
+  return false;
+}
+
+static class EventAllocatorTestSuite : public TestSuite
+{
+public:
+  EventAllocatorTestSuite ()
+    : TestSuite ("event-allocator", UNIT)
+  {
+    AddTestCase (new EventAllocatorTestCase ());
+    AddTestCase (new EventAllocatorThreadTestCase ());
+  }
+} g_eventAllocatorTestSuite;
+
+} // namespace ns3
@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_ALLOCATOR_H
+#define EVENT_ALLOCATOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ * \brief a size-class slab allocator for EventImpl instances
+ *
+ * Every EventImpl subclass (and, most notably, all the events created
+ * by MakeEvent and thus by Simulator::Schedule) is allocated through
+ * this allocator. Requests are rounded up to a multiple of 16 bytes
+ * and served from a per-size-class free list which is refilled by
+ * carving large slabs: the steady state of a simulation thus performs
+ * no call to malloc and free per event. Requests larger than the
+ * largest size class are forwarded to the global operator new.
+ *
+ * One pool is maintained per thread such that the simulation thread
+ * of the realtime and distributed simulator implementations never
+ * contends with other threads. Each slab records the pool which owns
+ * it: a block freed by a thread other than the one which allocated it,
+ * as happens with the events scheduled from another thread, is pushed
+ * on a lock-free list of its owner, which takes the blocks back the
+ * next time it allocates. When a thread exits, its pool is kept for
+ * the next thread which allocates events: slabs are never returned to
+ * the system. If the compiler does not support thread-local storage
+ * or if pthreads are not available, the allocator falls back to the
+ * global operator new and delete.
+ */
+class EventAllocator
+{
+public:
+  /**
+   * \brief allocation counters of the pool of the calling thread
+   */
+  struct Stats
+  {
+    // number of blocks allocated since the pool was created
+    uint64_t allocations;
+    // number of blocks released since the pool was created
+    uint64_t deallocations;
+    // number of allocations which were too large for the size classes
+    uint64_t largeAllocations;
+    // number of slabs obtained from the system
+    uint64_t slabs;
+    // number of blocks currently in use
+    int64_t live;
+    // the largest value ever reached by live
+    int64_t peak;
+  };
+
+  /**
+   * \param size the number of bytes to allocate
+   * \returns a buffer of at least size bytes
+   */
+  static void *Allocate (size_t size);
+  /**
+   * \param buffer a buffer returned by Allocate
+   * \param size the size which was passed to Allocate
+   */
+  static void Deallocate (void *buffer, size_t size);
+  /**
+   * \returns the counters of the pool of the calling thread, once
+   *          the blocks freed by other threads have been taken back.
+   */
+  static Stats GetStats (void);
+  /**
+   * Reset the peak counter of the pool of the calling thread
+   * to its current number of live blocks.
+   */
+  static void ResetPeak (void);
+};
+
+} // namespace ns3
+
+#endif /* EVENT_ALLOCATOR_H */
@@ -19,6 +19,7 @@
  */
 
 #include "event-impl.h"
+#include "event-allocator.h"
 
 namespace ns3 {
 
@@ -26,7 +27,8 @@ EventImpl::~EventImpl ()
 {}
 
 EventImpl::EventImpl ()
-  : m_cancel (false)
+  : m_cancel (false),
+    m_schedulerHandle (0)
 {}
 
 void 
@@ -50,4 +52,22 @@ EventImpl::IsCancelled (void)
   return m_cancel;
 }
 
+const void *
+EventImpl::GetFunction (void) const
+{
+  return 0;
+}
+
+void *
+EventImpl::operator new (size_t size)
+{
+  return EventAllocator::Allocate (size);
+}
+
+void
+EventImpl::operator delete (void *buffer, size_t size)
+{
+  EventAllocator::Deallocate (buffer, size);
+}
+
 } // namespace ns3
@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <stddef.h>
 #include "ns3/simple-ref-count.h"
 
 namespace ns3 {
@@ -58,13 +59,62 @@ public:
    */
   bool IsCancelled (void);
 
+  /**
+   * \param handle an opaque value
+   *
+   * Indexed schedulers (see Scheduler::IsIndexed) record here the
+   * position of the event in their event list so that they can
+   * remove it without searching for it.
+   */
+  void SetSchedulerHandle (uint32_t handle);
+  /**
+   * \returns the value last passed to SetSchedulerHandle.
+   */
+  uint32_t GetSchedulerHandle (void) const;
+
+  /**
+   * \returns the address of the function invoked by this event, or
+   *          another value which identifies it among the functions
+   *          with the same signature, or zero if it is unknown.
+   *
+   * The events created by MakeEvent return the function or member
+   * function they were created with. This is used by EventProfiler.
+   */
+  virtual const void *GetFunction (void) const;
+
+  /**
+   * All subclasses are allocated from the ns3::EventAllocator
+   * pools rather than from the heap.
+   */
+  static void *operator new (size_t size);
+  static void operator delete (void *buffer, size_t size);
+
 protected:
   virtual void Notify (void) = 0;
 
 private:
   bool m_cancel;
+  uint32_t m_schedulerHandle;
 };
 
 } // namespace ns3
 
+namespace ns3 {
+
+// the indexed schedulers update the handle each time they move an
+// event in their event list: keep this cheap.
+inline void
+EventImpl::SetSchedulerHandle (uint32_t handle)
+{
+  m_schedulerHandle = handle;
+}
+
+inline uint32_t
+EventImpl::GetSchedulerHandle (void) const
+{
+  return m_schedulerHandle;
+}
+
+} // namespace ns3
+
 #endif /* EVENT_IMPL_H */
@@ -0,0 +1,388 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-profiler.h"
+#include "event-impl.h"
+#include "ns3/simulator-config.h"
+#include "ns3/assert.h"
+
+#include <typeinfo>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/time.h>
+#ifdef __GNUC__
+#include <cxxabi.h>
+#endif
+#ifdef HAVE_DLADDR
+#include <dlfcn.h>
+#endif
+
+namespace ns3 {
+
+namespace {
+struct WallClockGreater
+{
+  bool operator () (const EventProfiler::Stats &a, const EventProfiler::Stats &b) const
+  {
+    if (a.wallClock != b.wallClock)
+      {
+        return a.wallClock > b.wallClock;
+      }
+    return a.name < b.name;
+  }
+};
+
+// The events created by Simulator::Schedule are local classes of
+// the MakeEvent templates: the template arguments identify the
+// signature of the function which is invoked, the rest is noise.
+std::string
+ShortenMakeEvent (const std::string &name)
+{
+  std::string::size_type start = name.find ("MakeEvent");
+  std::string::size_type end = start + 9;
+  if (start == std::string::npos || end == name.size ()
+      || (name[end] != '<' && name[end] != '('))
+    {
+      return name;
+    }
+  char open = name[end];
+  char close = (open == '<') ? '>' : ')';
+  end++;
+  for (int depth = 1; end < name.size () && depth > 0; end++)
+    {
+      if (name[end] == open)
+        {
+          depth++;
+        }
+      else if (name[end] == close)
+        {
+          depth--;
+        }
+    }
+  return name.substr (start, end - start);
+}
+} // anonymous namespace
+
+EventProfiler::EventProfiler ()
+{}
+
+uint64_t
+EventProfiler::GetWallClock (void)
+{
+#ifdef HAVE_CLOCK_GETTIME
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#else
+  struct timeval tv;
+  gettimeofday (&tv, 0);
+  return tv.tv_sec * 1000000000ULL + tv.tv_usec * 1000ULL;
+#endif
+}
+
+std::string
+EventProfiler::Demangle (const char *name)
+{
+  std::string result = name;
+#ifdef __GNUC__
+  int status;
+  char *demangled = abi::__cxa_demangle (name, 0, 0, &status);
+  if (status == 0 && demangled != 0)
+    {
+      result = demangled;
+    }
+  free (demangled);
+#endif
+  return result;
+}
+
+std::string
+EventProfiler::GetTypeName (EventImpl *event)
+{
+  const void *function = event->GetFunction ();
+#ifdef HAVE_DLADDR
+  Dl_info info;
+  if (function != 0 && dladdr (function, &info) != 0
+      && info.dli_sname != 0 && info.dli_saddr == function)
+    {
+      return Demangle (info.dli_sname);
+    }
+#endif
+  std::string name = ShortenMakeEvent (Demangle (typeid (*event).name ()));
+  if (function != 0)
+    {
+      // the function is not an exported symbol, or it is a virtual
+      // member function: tell it apart by its address or offset.
+      std::ostringstream oss;
+      oss << name << " [" << function << "]";
+      name = oss.str ();
+    }
+  return name;
+}
+
+EventProfiler::Stats *
+EventProfiler::Lookup (EventImpl *event)
+{
+  Key key = std::make_pair (typeid (*event).name (), event->GetFunction ());
+  StatsMap::iterator i = m_stats.find (key);
+  if (i == m_stats.end ())
+    {
+      Stats stats;
+      stats.name = GetTypeName (event);
+      stats.scheduled = 0;
+      stats.totalDelay = 0;
+      stats.maxDelay = 0;
+      stats.invoked = 0;
+      stats.cancelled = 0;
+      stats.wallClock = 0;
+      i = m_stats.insert (std::make_pair (key, stats)).first;
+    }
+  return &i->second;
+}
+
+void
+EventProfiler::RecordSchedule (EventImpl *event, uint64_t delay)
+{
+  Stats *stats = Lookup (event);
+  stats->scheduled++;
+  stats->totalDelay += delay;
+  stats->maxDelay = std::max (stats->maxDelay, delay);
+}
+
+void
+EventProfiler::RecordInvoke (EventImpl *event, uint64_t ns)
+{
+  Stats *stats = Lookup (event);
+  stats->invoked++;
+  stats->wallClock += ns;
+}
+
+void
+EventProfiler::RecordCancelled (EventImpl *event)
+{
+  Lookup (event)->cancelled++;
+}
+
+std::vector<EventProfiler::Stats>
+EventProfiler::GetStats (void) const
+{
+  // the same type may have several type_info instances when it
+  // is used from several shared libraries: merge them.
+  std::map<std::string, Stats> merged;
+  for (StatsMap::const_iterator i = m_stats.begin (); i != m_stats.end (); i++)
+    {
+      std::map<std::string, Stats>::iterator j = merged.find (i->second.name);
+      if (j == merged.end ())
+        {
+          merged[i->second.name] = i->second;
+          continue;
+        }
+      j->second.scheduled += i->second.scheduled;
+      j->second.totalDelay += i->second.totalDelay;
+      j->second.maxDelay = std::max (j->second.maxDelay, i->second.maxDelay);
+      j->second.invoked += i->second.invoked;
+      j->second.cancelled += i->second.cancelled;
+      j->second.wallClock += i->second.wallClock;
+    }
+  std::vector<Stats> stats;
+  for (std::map<std::string, Stats>::const_iterator i = merged.begin (); i != merged.end (); i++)
+    {
+      stats.push_back (i->second);
+    }
+  std::sort (stats.begin (), stats.end (), WallClockGreater ());
+  return stats;
+}
+
+void
+EventProfiler::Print (std::ostream &os, double timeStep) const
+{
+  std::vector<Stats> stats = GetStats ();
+  uint64_t total = 0;
+  for (std::vector<Stats>::const_iterator i = stats.begin (); i != stats.end (); i++)
+    {
+      total += i->wallClock;
+    }
+  std::ios_base::fmtflags flags = os.flags ();
+  os << "event profile: " << stats.size () << " event types, "
+     << total / 1e9 << "s spent in events" << std::endl;
+  os << std::setw (7) << "time%" << std::setw (12) << "time(s)"
+     << std::setw (12) << "invoked" << std::setw (10) << "ns/event"
+     << std::setw (12) << "scheduled" << std::setw (10) << "cancelled"
+     << std::setw (14) << "mean-ahead(s)" << std::setw (14) << "max-ahead(s)"
+     << "  type" << std::endl;
+  for (std::vector<Stats>::const_iterator i = stats.begin (); i != stats.end (); i++)
+    {
+      double share = (total == 0) ? 0 : 100.0 * i->wallClock / total;
+      double perEvent = (i->invoked == 0) ? 0 : (double)i->wallClock / i->invoked;
+      double meanDelay = (i->scheduled == 0) ? 0 : timeStep * i->totalDelay / i->scheduled;
+      os << std::fixed
+         << std::setw (7) << std::setprecision (2) << share
+         << std::setw (12) << std::setprecision (3) << i->wallClock / 1e9
+         << std::setw (12) << i->invoked
+         << std::setw (10) << std::setprecision (0) << perEvent
+         << std::setw (12) << i->scheduled
+         << std::setw (10) << i->cancelled
+         << std::setw (14) << std::setprecision (6) << meanDelay
+         << std::setw (14) << std::setprecision (6) << timeStep * i->maxDelay
+         << "  " << i->name << std::endl;
+    }
+  os.flags (flags);
+}
+
+} // namespace ns3
+
+#include "ns3/test.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "make-event.h"
+#include "simulator.h"
+#include "default-simulator-impl.h"
+#include <fstream>
+#include <sstream>
+
+namespace ns3 {
+
+class EventProfilerTestCase : public TestCase
+{
+public:
+  EventProfilerTestCase ();
+  void Foo (uint32_t a) {}
+  void Baz (uint32_t a) {}
+  static void Bar (void) {}
+private:
+  virtual bool DoRun (void);
+  static bool IsMemberLine (const std::string &line);
+};
+
+EventProfilerTestCase::EventProfilerTestCase ()
+  : TestCase ("Check that events are accounted per type")
+{}
+
+bool
+EventProfilerTestCase::IsMemberLine (const std::string &line)
+{
+  // the events of Foo and Baz, not those of Bar.
+  return line.find ("EventProfilerTestCase::") != std::string::npos
+    && line.find ("unsigned int") != std::string::npos;
+}
+
+bool
+EventProfilerTestCase::DoRun (void)
+{
+  EventProfiler profiler;
+  EventImpl *foo1 = MakeEvent (&EventProfilerTestCase::Foo, this, 1);
+  EventImpl *foo2 = MakeEvent (&EventProfilerTestCase::Foo, this, 2);
+  EventImpl *baz = MakeEvent (&EventProfilerTestCase::Baz, this, 3);
+  EventImpl *bar = MakeEvent (&EventProfilerTestCase::Bar);
+  profiler.RecordSchedule (foo1, 10);
+  profiler.RecordSchedule (foo2, 30);
+  profiler.RecordSchedule (baz, 20);
+  profiler.RecordSchedule (bar, 5);
+  profiler.RecordInvoke (foo1, 100);
+  profiler.RecordCancelled (foo2);
+  profiler.RecordInvoke (bar, 1000);
+  profiler.RecordInvoke (baz, 10);
+  foo1->Unref ();
+  foo2->Unref ();
+  baz->Unref ();
+  bar->Unref ();
+
+  std::vector<EventProfiler::Stats> stats = profiler.GetStats ();
+  NS_TEST_ASSERT_MSG_EQ (stats.size (), 3, "Events of the same function must share their statistics, "
+                         "events of different functions with the same signature must not");
+  // sorted by decreasing wall-clock time: bar, foo, baz.
+#ifdef HAVE_DLADDR
+  NS_TEST_EXPECT_MSG_EQ (stats[0].name, "ns3::EventProfilerTestCase::Bar()", "Unexpected name of a function event");
+  NS_TEST_EXPECT_MSG_EQ (stats[1].name, "ns3::EventProfilerTestCase::Foo(unsigned int)", "Unexpected name of a member event");
+  NS_TEST_EXPECT_MSG_EQ (stats[2].name, "ns3::EventProfilerTestCase::Baz(unsigned int)", "Unexpected name of a member event");
+#else
+  NS_TEST_EXPECT_MSG_EQ (stats[0].name.find ("MakeEvent(void (*)())"), 0, "Unexpected name of a function event");
+#endif
+  NS_TEST_EXPECT_MSG_EQ (stats[0].wallClock, 1000, "Unexpected wall-clock time");
+  NS_TEST_EXPECT_MSG_EQ (IsMemberLine (stats[1].name), true,
+                         "The name of a member event must contain its class: " << stats[1].name);
+  NS_TEST_EXPECT_MSG_NE (stats[1].name, stats[2].name, "Different member functions must have different names");
+  NS_TEST_EXPECT_MSG_EQ (stats[1].scheduled, 2, "Unexpected number of scheduled events");
+  NS_TEST_EXPECT_MSG_EQ (stats[1].invoked, 1, "Unexpected number of invoked events");
+  NS_TEST_EXPECT_MSG_EQ (stats[1].cancelled, 1, "Unexpected number of cancelled events");
+  NS_TEST_EXPECT_MSG_EQ (stats[1].totalDelay, 40, "Unexpected total delay");
+  NS_TEST_EXPECT_MSG_EQ (stats[1].maxDelay, 30, "Unexpected maximum delay");
+  NS_TEST_EXPECT_MSG_EQ (stats[2].scheduled, 1, "Unexpected number of scheduled events");
+  NS_TEST_EXPECT_MSG_EQ (stats[2].wallClock, 10, "Unexpected wall-clock time");
+
+  // the report of a real simulation is written at Simulator::Destroy
+  std::string output = GetTempDir () + "/event-profile.txt";
+  Ptr<DefaultSimulatorImpl> impl = CreateObject<DefaultSimulatorImpl> ();
+  impl->SetAttribute ("Profiling", BooleanValue (true));
+  impl->SetAttribute ("ProfilingOutput", StringValue (output));
+  Simulator::SetImplementation (impl);
+  Simulator::Schedule (Seconds (1), &EventProfilerTestCase::Foo, this, 1);
+  Simulator::Schedule (Seconds (2), &EventProfilerTestCase::Foo, this, 2);
+  EventId ev = Simulator::Schedule (Seconds (3), &EventProfilerTestCase::Foo, this, 3);
+  Simulator::Schedule (Seconds (1), &EventProfilerTestCase::Baz, this, 4);
+  Simulator::Schedule (Seconds (1), &EventProfilerTestCase::Bar);
+  Simulator::Cancel (ev);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::ifstream is (output.c_str ());
+  NS_TEST_ASSERT_MSG_EQ (is.is_open (), true, "The profiling report was not written");
+  std::string line;
+  uint32_t members = 0;
+  bool found = false;
+  while (std::getline (is, line))
+    {
+      if (!IsMemberLine (line))
+        {
+          continue;
+        }
+      members++;
+      std::istringstream iss (line);
+      double share, seconds, perEvent, meanAhead, maxAhead;
+      uint64_t invoked, scheduled, cancelled;
+      iss >> share >> seconds >> invoked >> perEvent >> scheduled >> cancelled >> meanAhead >> maxAhead;
+      if (scheduled != 3)
+        {
+          // the line of Baz
+          NS_TEST_EXPECT_MSG_EQ (scheduled, 1, "Unexpected number of scheduled events in the report");
+          NS_TEST_EXPECT_MSG_EQ (invoked, 1, "Unexpected number of invoked events in the report");
+          continue;
+        }
+      found = true;
+      NS_TEST_EXPECT_MSG_EQ (invoked, 2, "Unexpected number of invoked events in the report");
+      NS_TEST_EXPECT_MSG_EQ (cancelled, 1, "Unexpected number of cancelled events in the report");
+      NS_TEST_EXPECT_MSG_EQ_TOL (meanAhead, 2.0, 1e-6, "Unexpected mean scheduled-ahead distance");
+      NS_TEST_EXPECT_MSG_EQ_TOL (maxAhead, 3.0, 1e-6, "Unexpected maximum scheduled-ahead distance");
+    }
+  NS_TEST_EXPECT_MSG_EQ (members, 2, "Each member function must have its own line in the report");
+  NS_TEST_EXPECT_MSG_EQ (found, true, "The member events are missing from the report");
+  return false;
+}
+
+static class EventProfilerTestSuite : public TestSuite
+{
+public:
+  EventProfilerTestSuite ()
+    : TestSuite ("event-profiler", UNIT)
+  {
+    AddTestCase (new EventProfilerTestCase ());
+  }
+} g_eventProfilerTestSuite;
+
+} // namespace ns3
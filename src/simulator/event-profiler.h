@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+#include <ostream>
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup simulator
+ * \brief per event type execution statistics
+ *
+ * The type of an event is the concrete subclass of EventImpl which
+ * implements it together with the function it invokes, as returned by
+ * EventImpl::GetFunction: for the events created by Simulator::Schedule,
+ * this is the member function or function which is invoked, which the
+ * instantiation of MakeEvent alone does not tell apart from the other
+ * functions with the same signature. For each type, this class records
+ * the number of events
+ * scheduled and their scheduled-ahead distance, that is, the delay
+ * between the time they were scheduled and the time they expire, and
+ * the number of events invoked and the wall-clock time spent in them.
+ *
+ * This is used by DefaultSimulatorImpl when its Profiling attribute
+ * is set.
+ */
+class EventProfiler
+{
+public:
+  /**
+   * \brief the statistics of one event type
+   */
+  struct Stats
+  {
+    std::string name;
+    // number of events scheduled
+    uint64_t scheduled;
+    // sum and maximum of their delays, in time steps
+    uint64_t totalDelay;
+    uint64_t maxDelay;
+    // number of events invoked, not counting the cancelled ones
+    uint64_t invoked;
+    // number of events cancelled before they expired
+    uint64_t cancelled;
+    // wall-clock time spent in the invoked events, in nanoseconds
+    uint64_t wallClock;
+  };
+
+  EventProfiler ();
+
+  /**
+   * \param event an event which was just scheduled
+   * \param delay the delay until it expires, in time steps
+   */
+  void RecordSchedule (EventImpl *event, uint64_t delay);
+  /**
+   * \param event an event which was just invoked
+   * \param ns the wall-clock time spent in it, in nanoseconds
+   */
+  void RecordInvoke (EventImpl *event, uint64_t ns);
+  /**
+   * \param event an event which was just cancelled
+   */
+  void RecordCancelled (EventImpl *event);
+
+  /**
+   * \returns the statistics of all the event types, sorted by
+   *          decreasing wall-clock time.
+   */
+  std::vector<Stats> GetStats (void) const;
+  /**
+   * \param os the output stream
+   * \param timeStep the duration of a time step, in seconds
+   *
+   * Print one line per event type, sorted by decreasing wall-clock time.
+   */
+  void Print (std::ostream &os, double timeStep) const;
+
+  /**
+   * \returns a monotonic wall-clock timestamp, in nanoseconds.
+   */
+  static uint64_t GetWallClock (void);
+  /**
+   * \param event an event
+   * \returns the human-readable name of the type of the event: the
+   *          name of the function it invokes if it can be found in
+   *          the symbols of the program, the name of its class followed
+   *          by the value returned by EventImpl::GetFunction otherwise.
+   */
+  static std::string GetTypeName (EventImpl *event);
+
+private:
+  Stats *Lookup (EventImpl *event);
+  static std::string Demangle (const char *name);
+
+  // indexed by the address of the name of the class of the events,
+  // which is unique for each class and cheap to compare, and by the
+  // function they invoke.
+  typedef std::pair<const char *, const void *> Key;
+  typedef std::map<Key, Stats> StatsMap;
+  StatsMap m_stats;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
@@ -108,6 +108,8 @@ HeapScheduler::Exch (uint32_t a, uint32_t b)
   Event tmp (m_heap[a]);
   m_heap[a] = m_heap[b];
   m_heap[b] = tmp;
+  m_heap[a].impl->SetSchedulerHandle (a);
+  m_heap[b].impl->SetSchedulerHandle (b);
 }
 
 bool
@@ -129,9 +131,9 @@ HeapScheduler::IsEmpty (void) const
 }
 
 void
-HeapScheduler::BottomUp (void)
+HeapScheduler::BottomUp (uint32_t start)
 {
-  uint32_t index = Last ();
+  uint32_t index = start;
   while (!IsRoot (index)
          && IsLessStrictly (index, Parent (index)))
     {
@@ -179,7 +181,8 @@ void
 HeapScheduler::Insert (const Event &ev)
 {
   m_heap.push_back (ev);
-  BottomUp ();
+  ev.impl->SetSchedulerHandle (Last ());
+  BottomUp (Last ());
 }
 
 Scheduler::Event
@@ -201,19 +204,28 @@ HeapScheduler::RemoveNext (void)
 void
 HeapScheduler::Remove (const Event &ev)
 {
-  uint32_t uid = ev.key.m_uid;
-  for (uint32_t i = 1; i < m_heap.size (); i++)
+  uint32_t i = ev.impl->GetSchedulerHandle ();
+  NS_ASSERT (!IsEmpty ());
+  NS_ASSERT (i <= Last () && m_heap[i].key.m_uid == ev.key.m_uid);
+  NS_ASSERT (m_heap[i].impl == ev.impl);
+  Exch (i, Last ());
+  m_heap.pop_back ();
+  if (IsBottom (i))
     {
-      if (uid == m_heap[i].key.m_uid)
-        {
-          NS_ASSERT (m_heap[i].impl == ev.impl);
-          Exch (i, Last ());
-          m_heap.pop_back ();
-          TopDown (i);
-          return;
-        }
+      // we removed the last element.
+      return;
     }
-  NS_ASSERT (false);
+  // the element moved into the hole can be smaller than its new
+  // parent as well as larger than its new children: if BottomUp
+  // moves it up, TopDown finds nothing to do.
+  BottomUp (i);
+  TopDown (i);
+}
+
+bool
+HeapScheduler::IsIndexed (void) const
+{
+  return true;
 }
 
 } // namespace ns3
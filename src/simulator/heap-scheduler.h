@@ -43,6 +43,9 @@ namespace ns3 {
  *    the index of the root is 1.
  *  - It uses a slightly non-standard while loop for top-down heapify
  *    to move one if statement out of the loop.
+ *  - each event records its current index in the array with
+ *    EventImpl::SetSchedulerHandle so that Remove does not need
+ *    to search for it: it is a O(log n) heap fix-up.
  */
 class HeapScheduler : public Scheduler
 {
@@ -57,6 +60,7 @@ public:
   virtual Event PeekNext (void) const;
   virtual Event RemoveNext (void);
   virtual void Remove (const Event &ev);
+  virtual bool IsIndexed (void) const;
 
 private:
   typedef std::vector<Event> BinaryHeap;
@@ -74,7 +78,7 @@ private:
   inline uint32_t Smallest (uint32_t a, uint32_t b) const;
 
   inline void Exch (uint32_t a, uint32_t b);
-  void BottomUp (void);
+  void BottomUp (uint32_t start);
   void TopDown (uint32_t start);
 
   BinaryHeap m_heap;
@@ -0,0 +1,191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef HIGH_PRECISION_INT64_H
+#define HIGH_PRECISION_INT64_H
+
+#include <math.h>
+#include <stdint.h>
+#include <limits>
+#include <iostream>
+#include "ns3/assert.h"
+
+namespace ns3 {
+
+/**
+ * This implementation of the HighPrecision class stores a plain
+ * 64 bit signed integer: a Time is then an integer number of time
+ * steps and all the arithmetic operations are native integer
+ * operations.
+ *
+ * There is no fractional part: HighPrecision (double) rounds to the
+ * nearest integer, Div truncates and Invert (v) does not compute 1/v
+ * but returns v itself so that MulByInvert (Invert (v)) divides by v.
+ * The Time class takes care of the conversions from and to fractional
+ * values of the other time units.
+ *
+ * Overflows are detected by assertions so they are reported only in
+ * debug builds: optimized builds do not pay for the checks.
+ *
+ * Because fractional times are rounded rather than kept, simulations
+ * do not produce exactly the same event times as with the default
+ * implementation: the olsr, aodv, dot11s and flame regression traces
+ * are not reproduced in this mode.
+ */
+class HighPrecision
+{
+public:
+  inline HighPrecision ();
+  explicit inline HighPrecision (int64_t value, bool dummy);
+  explicit inline HighPrecision (double value);
+
+  inline int64_t GetInteger (void) const;
+  inline double GetDouble (void) const;
+  inline void Add (HighPrecision const &o);
+  inline void Sub (HighPrecision const &o);
+  inline void Mul (HighPrecision const &o);
+  inline void Div (HighPrecision const &o);
+  inline void MulByInvert (const HighPrecision &o);
+  inline static HighPrecision Invert (uint64_t v);
+
+  inline int Compare (HighPrecision const &o) const;
+  inline static HighPrecision Zero (void);
+  inline int64_t GetHigh (void) const;
+  inline uint64_t GetLow (void) const;
+
+private:
+  int64_t m_value;
+};
+
+inline std::ostream &operator << (std::ostream &os, const HighPrecision &hp);
+inline std::istream &operator >> (std::istream &is, HighPrecision &hp);
+
+} // namespace ns3
+
+namespace ns3 {
+
+HighPrecision::HighPrecision ()
+  : m_value (0)
+{}
+
+HighPrecision::HighPrecision (int64_t value, bool dummy)
+  : m_value (value)
+{}
+
+HighPrecision::HighPrecision (double value)
+{
+  NS_ASSERT_MSG (fabs (value) < 9.2233720368547758e18, "HighPrecision overflow: " << value);
+  m_value = (int64_t)((value < 0) ? (value - 0.5) : (value + 0.5));
+}
+
+int64_t
+HighPrecision::GetInteger (void) const
+{
+  return m_value;
+}
+
+double
+HighPrecision::GetDouble (void) const
+{
+  return (double)m_value;
+}
+
+void
+HighPrecision::Add (HighPrecision const &o)
+{
+  NS_ASSERT_MSG (!(o.m_value > 0 && m_value > std::numeric_limits<int64_t>::max () - o.m_value)
+                 && !(o.m_value < 0 && m_value < std::numeric_limits<int64_t>::min () - o.m_value),
+                 "HighPrecision overflow: " << m_value << "+" << o.m_value);
+  m_value += o.m_value;
+}
+
+void
+HighPrecision::Sub (HighPrecision const &o)
+{
+  NS_ASSERT_MSG (!(o.m_value < 0 && m_value > std::numeric_limits<int64_t>::max () + o.m_value)
+                 && !(o.m_value > 0 && m_value < std::numeric_limits<int64_t>::min () + o.m_value),
+                 "HighPrecision overflow: " << m_value << "-" << o.m_value);
+  m_value -= o.m_value;
+}
+
+void
+HighPrecision::Mul (HighPrecision const &o)
+{
+  NS_ASSERT_MSG (m_value == 0 || o.m_value == 0
+                 || fabs ((double)m_value * (double)o.m_value) < 9.2233720368547758e18,
+                 "HighPrecision overflow: " << m_value << "*" << o.m_value);
+  m_value *= o.m_value;
+}
+
+void
+HighPrecision::Div (HighPrecision const &o)
+{
+  NS_ASSERT_MSG (o.m_value != 0, "HighPrecision division by zero");
+  m_value /= o.m_value;
+}
+
+void
+HighPrecision::MulByInvert (const HighPrecision &o)
+{
+  Div (o);
+}
+
+HighPrecision
+HighPrecision::Invert (uint64_t v)
+{
+  return HighPrecision (v, false);
+}
+
+int
+HighPrecision::Compare (HighPrecision const &o) const
+{
+  return (m_value < o.m_value)?-1:(m_value == o.m_value)?0:1;
+}
+
+HighPrecision
+HighPrecision::Zero (void)
+{
+  return HighPrecision ();
+}
+
+int64_t
+HighPrecision::GetHigh (void) const
+{
+  return m_value;
+}
+
+uint64_t
+HighPrecision::GetLow (void) const
+{
+  return 0;
+}
+
+std::ostream &operator << (std::ostream &os, const HighPrecision &hp)
+{
+  os << hp.GetInteger ();
+  return os;
+}
+
+std::istream &operator >> (std::istream &is, HighPrecision &hp)
+{
+  int64_t value;
+  is >> value;
+  hp = HighPrecision (value, false);
+  return is;
+}
+
+} // namespace ns3
+
+#endif /* HIGH_PRECISION_INT64_H */
@@ -345,6 +345,72 @@ HpInvertTestCase::DoRun (void)
   return GetErrorStatus ();
 }
 
+#ifdef USE_HIGH_PRECISION_INT64
+class HpInt64ArithmeticTestCase : public TestCase
+{
+public:
+  HpInt64ArithmeticTestCase ();
+  virtual bool DoRun (void);
+};
+
+HpInt64ArithmeticTestCase::HpInt64ArithmeticTestCase ()
+  : TestCase ("Check the integer arithmetic of the int64 implementation")
+{
+}
+bool
+HpInt64ArithmeticTestCase::DoRun (void)
+{
+  HighPrecision a;
+  a = V (7);
+  a.Add (V (-10));
+  CHECK_EXPECTED (a, -3);
+  a.Sub (V (-5));
+  CHECK_EXPECTED (a, 2);
+  a.Mul (V (-21));
+  CHECK_EXPECTED (a, -42);
+  a = V (1000000000000000000LL);
+  a.Add (V (-1));
+  CHECK_EXPECTED (a, 999999999999999999LL);
+
+  // Div truncates toward zero
+  a = V (7);
+  a.Div (V (2));
+  CHECK_EXPECTED (a, 3);
+  a = V (-7);
+  a.Div (V (2));
+  CHECK_EXPECTED (a, -3);
+  a = V (1);
+  a.Div (V (3));
+  CHECK_EXPECTED (a, 0);
+
+  // the conversion from double rounds to the nearest integer
+  NS_TEST_ASSERT_MSG_EQ (HighPrecision (2.4).GetInteger (), 2, "2.4 rounds down");
+  NS_TEST_ASSERT_MSG_EQ (HighPrecision (2.5).GetInteger (), 3, "2.5 rounds up");
+  NS_TEST_ASSERT_MSG_EQ (HighPrecision (-2.5).GetInteger (), -3, "-2.5 rounds away from zero");
+  NS_TEST_ASSERT_MSG_EQ (HighPrecision (1e15).GetInteger (), 1000000000000000LL, "1e15 is exact");
+  NS_TEST_ASSERT_MSG_EQ (V (-12).GetDouble (), -12.0, "GetDouble");
+
+  // there is no fractional part
+  NS_TEST_ASSERT_MSG_EQ (V (5).GetHigh (), 5, "GetHigh is the value");
+  NS_TEST_ASSERT_MSG_EQ (V (5).GetLow (), (uint64_t)0, "GetLow is always zero");
+
+  // MulByInvert (Invert (v)) divides by v
+  a = V (1000000000);
+  a.MulByInvert (HighPrecision::Invert (1000));
+  CHECK_EXPECTED (a, 1000000);
+  a = V (-999);
+  a.MulByInvert (HighPrecision::Invert (1000));
+  CHECK_EXPECTED (a, 0);
+
+  NS_TEST_ASSERT_MSG_EQ (V (-1).Compare (V (1)), -1, "-1 < 1");
+  NS_TEST_ASSERT_MSG_EQ (V (3).Compare (V (3)), 0, "3 == 3");
+  NS_TEST_ASSERT_MSG_EQ (V (4).Compare (V (-4)), 1, "4 > -4");
+  NS_TEST_ASSERT_MSG_EQ (HighPrecision::Zero ().GetInteger (), 0, "Zero");
+
+  return GetErrorStatus ();
+}
+#endif /* USE_HIGH_PRECISION_INT64 */
+
 
 static class HighPrecisionTestSuite : public TestSuite
 {
@@ -352,9 +418,14 @@ public:
   HighPrecisionTestSuite ()
     : TestSuite ("high-precision", UNIT)
   {
+#ifndef USE_HIGH_PRECISION_INT64
+    // the int64 implementation has no fractional part.
     AddTestCase (new HpArithmeticTestCase ());
     AddTestCase (new HpBug455TestCase ());
     AddTestCase (new HpBug863TestCase ());
+#else
+    AddTestCase (new HpInt64ArithmeticTestCase ());
+#endif
     AddTestCase (new HpCompareTestCase ());
     AddTestCase (new HpInvertTestCase ());
   }
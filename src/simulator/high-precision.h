@@ -29,6 +29,8 @@
 #include "high-precision-128.h"
 #elif defined (USE_HIGH_PRECISION_CAIRO)
 #include "high-precision-cairo.h"
+#elif defined (USE_HIGH_PRECISION_INT64)
+#include "high-precision-int64.h"
 #endif
 
 namespace ns3 {
@@ -0,0 +1,356 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+#include "event-impl.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("LadderScheduler");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+// a bucket which holds more events than this is split into a
+// new rung rather than sorted into the bottom.
+static const uint32_t LADDER_THRESHOLD = 50;
+// the maximum number of rungs in the ladder.
+static const uint32_t LADDER_MAX_RUNGS = 8;
+
+namespace {
+struct EventGreater
+{
+  bool operator () (const Scheduler::Event &a, const Scheduler::Event &b) const
+  {
+    return a.key > b.key;
+  }
+};
+} // anonymous namespace
+
+TypeId
+LadderScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderScheduler")
+    .SetParent<Scheduler> ()
+    .AddConstructor<LadderScheduler> ()
+  ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_topStart (0),
+    m_topMin (0),
+    m_topMax (0),
+    m_nRungs (0),
+    m_size (0)
+{
+  // rungs are never re-allocated such that references to
+  // them stay valid while a child rung is spawned.
+  m_rungs.resize (LADDER_MAX_RUNGS);
+}
+
+LadderScheduler::~LadderScheduler ()
+{
+}
+
+uint64_t
+LadderScheduler::CurrentStart (const Rung &rung) const
+{
+  return rung.start + rung.current * rung.width;
+}
+
+void
+LadderScheduler::InitRung (uint64_t start, uint64_t width, uint32_t nBuckets)
+{
+  NS_LOG_FUNCTION (this << start << width << nBuckets);
+  NS_ASSERT (m_nRungs < LADDER_MAX_RUNGS);
+  Rung &rung = m_rungs[m_nRungs];
+  if (rung.buckets.size () < nBuckets)
+    {
+      rung.buckets.resize (nBuckets);
+    }
+  rung.nBuckets = nBuckets;
+  rung.current = 0;
+  rung.start = start;
+  rung.width = width;
+  m_nRungs++;
+}
+
+void
+LadderScheduler::TransferToBottom (Bucket &bucket)
+{
+  NS_ASSERT (m_bottom.empty ());
+  m_bottom.swap (bucket);
+  std::sort (m_bottom.begin (), m_bottom.end (), EventGreater ());
+  // recycle the storage of the previous bottom.
+  bucket.clear ();
+}
+
+void
+LadderScheduler::InsertInBottom (const Event &ev)
+{
+  Bucket::iterator i = std::lower_bound (m_bottom.begin (), m_bottom.end (), ev, EventGreater ());
+  m_bottom.insert (i, ev);
+  // bottom is sorted by decreasing key so its span is front - back.
+  if (m_bottom.size () > LADDER_THRESHOLD
+      && m_nRungs < LADDER_MAX_RUNGS
+      && m_bottom.front ().key.m_ts != m_bottom.back ().key.m_ts)
+    {
+      SpawnFromBottom ();
+    }
+}
+
+void
+LadderScheduler::SpawnFromBottom (void)
+{
+  // the new rung covers everything below the lowest tier which is
+  // already in use so that later insertions always find their bucket.
+  uint64_t start = m_bottom.back ().key.m_ts;
+  uint64_t end = (m_nRungs == 0) ? m_topStart : CurrentStart (m_rungs[m_nRungs - 1]);
+  NS_LOG_FUNCTION (this << m_bottom.size () << start << end);
+  NS_ASSERT (m_bottom.front ().key.m_ts < end);
+  uint64_t width = (end - start) / m_bottom.size () + 1;
+  uint32_t nBuckets = (end - start + width - 1) / width;
+  InitRung (start, width, nBuckets);
+  Rung &rung = m_rungs[m_nRungs - 1];
+  for (Bucket::const_iterator i = m_bottom.begin (); i != m_bottom.end (); i++)
+    {
+      rung.buckets[(i->key.m_ts - start) / width].push_back (*i);
+    }
+  m_bottom.clear ();
+  Refill ();
+}
+
+bool
+LadderScheduler::RemoveFromBucket (Bucket &bucket, const Event &ev)
+{
+  for (Bucket::iterator i = bucket.begin (); i != bucket.end (); i++)
+    {
+      if (i->key.m_uid == ev.key.m_uid)
+        {
+          NS_ASSERT (i->impl == ev.impl);
+          *i = bucket.back ();
+          bucket.pop_back ();
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+LadderScheduler::TransferTop (void)
+{
+  NS_LOG_FUNCTION (this << m_top.size () << m_topMin << m_topMax);
+  NS_ASSERT (m_nRungs == 0 && !m_top.empty ());
+  if (m_top.size () <= LADDER_THRESHOLD)
+    {
+      m_topStart = m_topMax + 1;
+      TransferToBottom (m_top);
+      return;
+    }
+  uint64_t width = (m_topMax - m_topMin) / m_top.size () + 1;
+  uint32_t nBuckets = (m_topMax - m_topMin) / width + 1;
+  InitRung (m_topMin, width, nBuckets);
+  Rung &rung = m_rungs[0];
+  for (Bucket::const_iterator i = m_top.begin (); i != m_top.end (); i++)
+    {
+      rung.buckets[(i->key.m_ts - rung.start) / width].push_back (*i);
+    }
+  m_top.clear ();
+  m_topStart = rung.start + nBuckets * width;
+}
+
+void
+LadderScheduler::Refill (void)
+{
+  while (m_bottom.empty () && m_size > 0)
+    {
+      if (m_nRungs == 0)
+        {
+          TransferTop ();
+          continue;
+        }
+      Rung &rung = m_rungs[m_nRungs - 1];
+      while (rung.current < rung.nBuckets && rung.buckets[rung.current].empty ())
+        {
+          rung.current++;
+        }
+      if (rung.current == rung.nBuckets)
+        {
+          m_nRungs--;
+          continue;
+        }
+      Bucket &bucket = rung.buckets[rung.current];
+      uint64_t bucketStart = CurrentStart (rung);
+      rung.current++;
+      if (bucket.size () <= LADDER_THRESHOLD
+          || rung.width == 1
+          || m_nRungs == LADDER_MAX_RUNGS)
+        {
+          TransferToBottom (bucket);
+          continue;
+        }
+      uint64_t width = rung.width / bucket.size ();
+      if (width == 0)
+        {
+          width = 1;
+        }
+      uint32_t nBuckets = (rung.width + width - 1) / width;
+      InitRung (bucketStart, width, nBuckets);
+      Rung &child = m_rungs[m_nRungs - 1];
+      for (Bucket::const_iterator i = bucket.begin (); i != bucket.end (); i++)
+        {
+          child.buckets[(i->key.m_ts - bucketStart) / width].push_back (*i);
+        }
+      bucket.clear ();
+    }
+}
+
+void
+LadderScheduler::Insert (const Event &ev)
+{
+  uint64_t ts = ev.key.m_ts;
+  m_size++;
+  if (ts >= m_topStart)
+    {
+      if (m_top.empty ())
+        {
+          m_topMin = ts;
+          m_topMax = ts;
+        }
+      m_topMin = std::min (m_topMin, ts);
+      m_topMax = std::max (m_topMax, ts);
+      m_top.push_back (ev);
+    }
+  else
+    {
+      bool inserted = false;
+      for (uint32_t i = 0; i < m_nRungs; i++)
+        {
+          Rung &rung = m_rungs[i];
+          if (ts >= CurrentStart (rung))
+            {
+              rung.buckets[(ts - rung.start) / rung.width].push_back (ev);
+              inserted = true;
+              break;
+            }
+        }
+      if (!inserted)
+        {
+          InsertInBottom (ev);
+        }
+    }
+  if (m_bottom.empty ())
+    {
+      Refill ();
+    }
+}
+
+bool
+LadderScheduler::IsEmpty (void) const
+{
+  return m_size == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext (void) const
+{
+  NS_ASSERT (!IsEmpty ());
+  return m_bottom.back ();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext (void)
+{
+  NS_ASSERT (!IsEmpty ());
+  Event next = m_bottom.back ();
+  m_bottom.pop_back ();
+  m_size--;
+  if (m_bottom.empty ())
+    {
+      Refill ();
+    }
+  return next;
+}
+
+void
+LadderScheduler::Remove (const Event &ev)
+{
+  NS_ASSERT (!IsEmpty ());
+  uint64_t ts = ev.key.m_ts;
+  bool removed = false;
+  if (ts >= m_topStart)
+    {
+      removed = RemoveFromBucket (m_top, ev);
+    }
+  else
+    {
+      bool found = false;
+      for (uint32_t i = 0; i < m_nRungs; i++)
+        {
+          Rung &rung = m_rungs[i];
+          if (ts >= CurrentStart (rung))
+            {
+              removed = RemoveFromBucket (rung.buckets[(ts - rung.start) / rung.width], ev);
+              found = true;
+              break;
+            }
+        }
+      if (!found)
+        {
+          Bucket::iterator i = std::lower_bound (m_bottom.begin (), m_bottom.end (), ev, EventGreater ());
+          if (i != m_bottom.end () && i->key.m_uid == ev.key.m_uid)
+            {
+              m_bottom.erase (i);
+              removed = true;
+            }
+        }
+    }
+  NS_ASSERT (removed);
+  m_size--;
+  if (m_bottom.empty ())
+    {
+      Refill ();
+    }
+}
+
+void
+LadderScheduler::RemoveNextBatch (uint64_t maxTs, std::vector<Event> &events)
+{
+  while (!m_bottom.empty () && m_bottom.back ().key.m_ts <= maxTs)
+    {
+      // bottom is sorted by decreasing key: find the start of the
+      // range of events to detach and move it in one go.
+      Bucket::iterator start = m_bottom.end () - 1;
+      while (start != m_bottom.begin () && (start - 1)->key.m_ts <= maxTs)
+        {
+          start--;
+        }
+      uint32_t n = m_bottom.end () - start;
+      events.insert (events.end (), Bucket::reverse_iterator (m_bottom.end ()),
+                     Bucket::reverse_iterator (start));
+      m_bottom.erase (start, m_bottom.end ());
+      m_size -= n;
+      if (m_bottom.empty ())
+        {
+          Refill ();
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the algorithm described in
+ * "Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by W.T. Tang, R.S.M. Goh and I.L.J. Thng
+ * (ACM TOMACS, 2005). The queue is made of three tiers:
+ *  - Top: an unsorted array which receives the events scheduled
+ *    far in the future.
+ *  - Ladder: a set of rungs, each made of an array of buckets. The
+ *    first rung is created from the content of Top, with a bucket
+ *    width derived from the span of the timestamps it contains.
+ *    A bucket which holds too many events when it is reached is not
+ *    sorted but spawns a finer-grained child rung.
+ *  - Bottom: a small sorted array from which events are dequeued.
+ *    The events scheduled before the current bucket of the lowest
+ *    rung are inserted in it directly: when it grows past the bucket
+ *    threshold, its content is moved to a new rung such that
+ *    short-horizon events do not turn it into a large sorted array.
+ *
+ * Contrary to the CalendarScheduler, the bucket widths are derived
+ * from the actual events rather than from a sample of them, which
+ * makes this queue robust to very skewed event distributions such as
+ * a mix of slot-level timers and events scheduled at the end of the
+ * simulation. All tiers are vector-backed: storage is recycled across
+ * epochs so that no allocation is required per event.
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  LadderScheduler ();
+  virtual ~LadderScheduler ();
+
+  virtual void Insert (const Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Event PeekNext (void) const;
+  virtual Event RemoveNext (void);
+  virtual void Remove (const Event &ev);
+  virtual void RemoveNextBatch (uint64_t maxTs, std::vector<Event> &events);
+
+private:
+  typedef std::vector<Scheduler::Event> Bucket;
+  struct Rung
+  {
+    std::vector<Bucket> buckets;
+    // the number of buckets in use in this rung
+    uint32_t nBuckets;
+    // the index of the first bucket not yet transferred to a lower tier
+    uint32_t current;
+    // the timestamp at the start of the first bucket
+    uint64_t start;
+    // the duration of each bucket
+    uint64_t width;
+  };
+
+  inline uint64_t CurrentStart (const Rung &rung) const;
+  void InitRung (uint64_t start, uint64_t width, uint32_t nBuckets);
+  void TransferToBottom (Bucket &bucket);
+  void InsertInBottom (const Event &ev);
+  void SpawnFromBottom (void);
+  static bool RemoveFromBucket (Bucket &bucket, const Event &ev);
+  void TransferTop (void);
+  void Refill (void);
+
+  Bucket m_top;
+  // the smallest timestamp which goes into m_top
+  uint64_t m_topStart;
+  uint64_t m_topMin;
+  uint64_t m_topMax;
+  // rungs are allocated once and reused: only the first
+  // m_nRungs entries are in use.
+  std::vector<Rung> m_rungs;
+  uint32_t m_nRungs;
+  // sorted by decreasing key so that the next event is at the back.
+  Bucket m_bottom;
+  // total number of events in all tiers
+  uint32_t m_size;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
@@ -22,6 +22,10 @@ protected:
     {
       (*m_function)();
     }
+    virtual const void *GetFunction (void) const
+    {
+      return GetEventFunction (m_function);
+    }
 private:
     F m_function;
   } *ev = new EventFunctionImpl0 (f);
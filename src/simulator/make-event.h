@@ -58,9 +58,22 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5), T1 a1, T2 a2, T3 a3, T4 a4, T5
 
 #include "event-impl.h"
 #include "ns3/type-traits.h"
+#include <string.h>
 
 namespace ns3 {
 
+// With the usual ABIs, the first word of a pointer to member function
+// is either the address of the function or, for a virtual function,
+// its offset in the virtual table: both tell apart the member functions
+// of a class. The first word of a pointer to function is its address.
+template <typename F>
+const void *GetEventFunction (F f)
+{
+  const void *p = 0;
+  memcpy (&p, &f, (sizeof (f) < sizeof (p)) ? sizeof (f) : sizeof (p));
+  return p;
+}
+
 template <typename T>
 struct EventMemberImplObjTraits;
 
@@ -93,6 +106,10 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)();
     }
+    virtual const void *GetFunction (void) const
+    {
+      return GetEventFunction (m_function);
+    }
     OBJ m_obj;
     MEM m_function;
   } *ev = new EventMemberImpl0 (obj, mem_ptr);
@@ -123,6 +140,10 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1);
     }
+    virtual const void *GetFunction (void) const
+    {
+      return GetEventFunction (m_function);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -154,6 +175,10 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2);
     }
+    virtual const void *GetFunction (void) const
+    {
+      return GetEventFunction (m_function);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -187,6 +212,10 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3);
     }
+    virtual const void *GetFunction (void) const
+    {
+      return GetEventFunction (m_function);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -222,6 +251,10 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4);
     }
+    virtual const void *GetFunction (void) const
+    {
+      return GetEventFunction (m_function);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -260,6 +293,10 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
     }
+    virtual const void *GetFunction (void) const
+    {
+      return GetEventFunction (m_function);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -294,6 +331,10 @@ private:
     {
       (*m_function)(m_a1);
     }
+    virtual const void *GetFunction (void) const
+    {
+      return GetEventFunction (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
   } *ev = new EventFunctionImpl1 (f, a1);
@@ -324,6 +365,10 @@ private:
     {
       (*m_function)(m_a1, m_a2);
     }
+    virtual const void *GetFunction (void) const
+    {
+      return GetEventFunction (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -357,6 +402,10 @@ private:
     {
       (*m_function)(m_a1, m_a2, m_a3);
     }
+    virtual const void *GetFunction (void) const
+    {
+      return GetEventFunction (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -392,6 +441,10 @@ private:
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4);
     }
+    virtual const void *GetFunction (void) const
+    {
+      return GetEventFunction (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -429,6 +482,10 @@ private:
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
     }
+    virtual const void *GetFunction (void) const
+    {
+      return GetEventFunction (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -100,4 +100,19 @@ MapScheduler::Remove (const Event &ev)
   m_list.erase (i);
 }
 
+void
+MapScheduler::RemoveNextBatch (uint64_t maxTs, std::vector<Event> &events)
+{
+  NS_LOG_FUNCTION (this << maxTs);
+  EventMapI i;
+  for (i = m_list.begin (); i != m_list.end () && i->first.m_ts <= maxTs; i++)
+    {
+      Event ev;
+      ev.impl = i->second;
+      ev.key = i->first;
+      events.push_back (ev);
+    }
+  m_list.erase (m_list.begin (), i);
+}
+
 } // namespace ns3
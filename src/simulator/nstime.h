@@ -30,6 +30,23 @@
 
 namespace ns3 {
 
+#ifdef USE_HIGH_PRECISION_INT64
+/**
+ * The number of nanoseconds in one unit U, where U is one of the
+ * Time::Unit values S, MS, US and NS.
+ */
+template <int U>
+struct TimeNsFactor
+{
+  static const int64_t VALUE = 1000 * TimeNsFactor<U + 1>::VALUE;
+};
+template <>
+struct TimeNsFactor<3>
+{
+  static const int64_t VALUE = 1;
+};
+#endif /* USE_HIGH_PRECISION_INT64 */
+
 
 /**
  * \ingroup simulator
@@ -260,7 +277,11 @@ public:
    */
   inline double GetSeconds (void) const
   {
+#ifdef USE_HIGH_PRECISION_INT64
+    return ToDouble<Time::S> (*this);
+#else
     return ToDouble (*this, Time::S);
+#endif
   }
 
   /**
@@ -269,7 +290,11 @@ public:
    */
   inline int64_t GetMilliSeconds (void) const
   {
+#ifdef USE_HIGH_PRECISION_INT64
+    return ToInteger<Time::MS> (*this);
+#else
     return ToInteger (*this, Time::MS);
+#endif
   }
   /**
    * \returns an approximation in microseconds of the time stored in this
@@ -277,7 +302,11 @@ public:
    */
   inline int64_t GetMicroSeconds (void) const
   {
+#ifdef USE_HIGH_PRECISION_INT64
+    return ToInteger<Time::US> (*this);
+#else
     return ToInteger (*this, Time::US);
+#endif
   }
   /**
    * \returns an approximation in nanoseconds of the time stored in this
@@ -285,7 +314,11 @@ public:
    */
   inline int64_t GetNanoSeconds (void) const
   {
+#ifdef USE_HIGH_PRECISION_INT64
+    return ToInteger<Time::NS> (*this);
+#else
     return ToInteger (*this, Time::NS);
+#endif
   }
   /**
    * \returns an approximation in picoseconds of the time stored in this
@@ -355,7 +388,17 @@ public:
    */
   inline static Time FromDouble (double value, enum Unit timeUnit)
   {
+#ifdef USE_HIGH_PRECISION_INT64
+    // the value must be scaled before it is rounded to an integer.
+    struct Information *info = PeekInformation (timeUnit);
+    if (info->fromMul)
+      {
+        return Time (HighPrecision (value * info->factor));
+      }
+    return Time (HighPrecision (value / info->factor));
+#else
     return From (HighPrecision (value), timeUnit);
+#endif
   }
   /**
    * \param time a Time object
@@ -387,9 +430,84 @@ public:
    */
   inline static double ToDouble (const Time &time, enum Unit timeUnit)
   {
+#ifdef USE_HIGH_PRECISION_INT64
+    struct Information *info = PeekInformation (timeUnit);
+    double v = time.m_data.GetDouble ();
+    if (info->toMul)
+      {
+        return v * info->factor;
+      }
+    return v / info->factor;
+#else
     return To (time, timeUnit).GetDouble ();
+#endif
   }
 
+#ifdef USE_HIGH_PRECISION_INT64
+  /**
+   * \param value to convert into a Time object
+   * \return a new Time object
+   *
+   * Same as FromInteger (value, U) but, with the default nanosecond
+   * resolution, the conversion factor is a compile-time constant.
+   * U must be one of S, MS, US and NS.
+   */
+  template <enum Unit U>
+  inline static Time FromInteger (uint64_t value)
+  {
+    if (PeekResolution ()->unit == NS)
+      {
+        return Time (HighPrecision ((int64_t)value * TimeNsFactor<U>::VALUE, false));
+      }
+    return FromInteger (value, U);
+  }
+  /**
+   * \param value to convert into a Time object
+   * \return a new Time object
+   *
+   * Same as FromDouble (value, U), see FromInteger<U>.
+   */
+  template <enum Unit U>
+  inline static Time FromDouble (double value)
+  {
+    if (PeekResolution ()->unit == NS)
+      {
+        return Time (HighPrecision (value * TimeNsFactor<U>::VALUE));
+      }
+    return FromDouble (value, U);
+  }
+  /**
+   * \param time a Time object
+   * \return the time in the unit U.
+   *
+   * Same as ToInteger (time, U), see FromInteger<U>.
+   */
+  template <enum Unit U>
+  inline static int64_t ToInteger (const Time &time)
+  {
+    if (PeekResolution ()->unit == NS)
+      {
+        return time.m_data.GetInteger () / TimeNsFactor<U>::VALUE;
+      }
+    return ToInteger (time, U);
+  }
+  /**
+   * \param time a Time object
+   * \return the time in the unit U.
+   *
+   * Same as ToDouble (time, U), see FromInteger<U>.
+   */
+  template <enum Unit U>
+  inline static double ToDouble (const Time &time)
+  {
+    if (PeekResolution ()->unit == NS)
+      {
+        return time.m_data.GetDouble () / TimeNsFactor<U>::VALUE;
+      }
+    return ToDouble (time, U);
+  }
+#endif /* USE_HIGH_PRECISION_INT64 */
+
 private:
   struct Information
   {
@@ -585,7 +703,11 @@ std::istream& operator>> (std::istream& is, Time & time);
  */
 inline Time Seconds (double seconds)
 {
+#ifdef USE_HIGH_PRECISION_INT64
+  return Time::FromDouble<Time::S> (seconds);
+#else
   return Time::FromDouble (seconds, Time::S);
+#endif
 }
 
 /**
@@ -600,7 +722,11 @@ inline Time Seconds (double seconds)
  */
 inline Time MilliSeconds (uint64_t ms)
 {
+#ifdef USE_HIGH_PRECISION_INT64
+  return Time::FromInteger<Time::MS> (ms);
+#else
   return Time::FromInteger (ms, Time::MS);
+#endif
 }
 /**
  * \brief create ns3::Time instances in units of microseconds.
@@ -614,7 +740,11 @@ inline Time MilliSeconds (uint64_t ms)
  */
 inline Time MicroSeconds (uint64_t us)
 {
+#ifdef USE_HIGH_PRECISION_INT64
+  return Time::FromInteger<Time::US> (us);
+#else
   return Time::FromInteger (us, Time::US);
+#endif
 }
 /**
  * \brief create ns3::Time instances in units of nanoseconds.
@@ -628,7 +758,11 @@ inline Time MicroSeconds (uint64_t us)
  */
 inline Time NanoSeconds (uint64_t ns)
 {
+#ifdef USE_HIGH_PRECISION_INT64
+  return Time::FromInteger<Time::NS> (ns);
+#else
   return Time::FromInteger (ns, Time::NS);
+#endif
 }
 /**
  * \brief create ns3::Time instances in units of picoseconds.
@@ -701,6 +835,26 @@ private:
   double m_v;
 };
 
+#ifdef USE_HIGH_PRECISION_INT64
+/*
+ * A Time holds an integer number of time steps: the products and
+ * quotients by fractional scalars must be computed before rounding.
+ */
+inline Time operator * (Time const &lhs, Scalar const &rhs)
+{
+  return Time (HighPrecision (lhs.GetHighPrecision ().GetDouble () * rhs.GetDouble ()));
+}
+inline Time operator * (Scalar const &lhs, Time const &rhs)
+{
+  return Time (HighPrecision (lhs.GetDouble () * rhs.GetHighPrecision ().GetDouble ()));
+}
+inline Time operator / (Time const &lhs, Scalar const &rhs)
+{
+  NS_ASSERT (rhs.GetDouble () != 0);
+  return Time (HighPrecision (lhs.GetHighPrecision ().GetDouble () / rhs.GetDouble ()));
+}
+#endif /* USE_HIGH_PRECISION_INT64 */
+
 typedef Time TimeInvert;
 typedef Time TimeSquare;
 
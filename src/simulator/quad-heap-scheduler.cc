@@ -0,0 +1,246 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "quad-heap-scheduler.h"
+#include "event-impl.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include <algorithm>
+#include <string.h>
+
+NS_LOG_COMPONENT_DEFINE ("QuadHeapScheduler");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (QuadHeapScheduler);
+
+// the size of a cache line we align the heap storage on.
+static const uintptr_t CACHE_LINE_SIZE = 64;
+// the initial number of slots allocated in the heap.
+static const uint32_t INITIAL_CAPACITY = 256;
+
+TypeId
+QuadHeapScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::QuadHeapScheduler")
+    .SetParent<Scheduler> ()
+    .AddConstructor<QuadHeapScheduler> ()
+  ;
+  return tid;
+}
+
+QuadHeapScheduler::QuadHeapScheduler ()
+  : m_buffer (0),
+    m_heap (0),
+    m_end (Root ()),
+    m_capacity (0)
+{
+  Grow ();
+}
+
+QuadHeapScheduler::~QuadHeapScheduler ()
+{
+  delete [] m_buffer;
+  m_buffer = 0;
+  m_heap = 0;
+}
+
+/*
+ * The root of the heap is stored at index 3 rather than at index 0:
+ * with this offset, the children of the node stored at index i are
+ * stored at indexes 4i-8 to 4i-5 which always start on a multiple of
+ * four. Since each node is 32 bytes long and the array itself is
+ * aligned on a cache line, a sibling group never straddles more
+ * cache lines than it needs to.
+ */
+uint32_t
+QuadHeapScheduler::Root (void) const
+{
+  return 3;
+}
+bool
+QuadHeapScheduler::IsRoot (uint32_t id) const
+{
+  return id == Root ();
+}
+uint32_t
+QuadHeapScheduler::Parent (uint32_t id) const
+{
+  return id / 4 + 2;
+}
+uint32_t
+QuadHeapScheduler::FirstChild (uint32_t id) const
+{
+  return id * 4 - 8;
+}
+
+void
+QuadHeapScheduler::Grow (void)
+{
+  uint32_t capacity = (m_capacity == 0) ? INITIAL_CAPACITY : m_capacity * 2;
+  NS_LOG_DEBUG ("Grow heap to " << capacity << " slots");
+  uint8_t *buffer = new uint8_t [capacity * sizeof (Node) + CACHE_LINE_SIZE - 1];
+  uintptr_t aligned = ((uintptr_t)buffer + CACHE_LINE_SIZE - 1) & ~(CACHE_LINE_SIZE - 1);
+  Node *heap = (Node *)aligned;
+  if (m_heap != 0)
+    {
+      memcpy (heap, m_heap, m_end * sizeof (Node));
+    }
+  delete [] m_buffer;
+  m_buffer = buffer;
+  m_heap = heap;
+  m_capacity = capacity;
+}
+
+void
+QuadHeapScheduler::Store (uint32_t index, const Event &ev)
+{
+  m_heap[index].ev = ev;
+  ev.impl->SetSchedulerHandle (index);
+}
+
+void
+QuadHeapScheduler::BottomUp (uint32_t index, const Event &ev)
+{
+  while (!IsRoot (index))
+    {
+      uint32_t parent = Parent (index);
+      if (!(ev.key < m_heap[parent].ev.key))
+        {
+          break;
+        }
+      Store (index, m_heap[parent].ev);
+      index = parent;
+    }
+  Store (index, ev);
+}
+
+void
+QuadHeapScheduler::TopDown (uint32_t index, const Event &ev)
+{
+  while (true)
+    {
+      uint32_t first = FirstChild (index);
+      if (first >= m_end)
+        {
+          break;
+        }
+      uint32_t last = std::min (first + 4, m_end);
+      uint32_t smallest = first;
+      for (uint32_t i = first + 1; i < last; i++)
+        {
+          if (m_heap[i].ev.key < m_heap[smallest].ev.key)
+            {
+              smallest = i;
+            }
+        }
+      if (!(m_heap[smallest].ev.key < ev.key))
+        {
+          break;
+        }
+      Store (index, m_heap[smallest].ev);
+      index = smallest;
+    }
+  Store (index, ev);
+}
+
+void
+QuadHeapScheduler::RemoveRoot (void)
+{
+  NS_ASSERT (!IsEmpty ());
+  m_end--;
+  if (m_end > Root ())
+    {
+      Event last = m_heap[m_end].ev;
+      TopDown (Root (), last);
+    }
+}
+
+void
+QuadHeapScheduler::Insert (const Event &ev)
+{
+  if (m_end == m_capacity)
+    {
+      Grow ();
+    }
+  m_end++;
+  BottomUp (m_end - 1, ev);
+}
+
+bool
+QuadHeapScheduler::IsEmpty (void) const
+{
+  return m_end == Root ();
+}
+
+Scheduler::Event
+QuadHeapScheduler::PeekNext (void) const
+{
+  NS_ASSERT (!IsEmpty ());
+  return m_heap[Root ()].ev;
+}
+
+Scheduler::Event
+QuadHeapScheduler::RemoveNext (void)
+{
+  Event next = m_heap[Root ()].ev;
+  RemoveRoot ();
+  return next;
+}
+
+void
+QuadHeapScheduler::Remove (const Event &ev)
+{
+  NS_ASSERT (!IsEmpty ());
+  uint32_t index = ev.impl->GetSchedulerHandle ();
+  NS_ASSERT (index >= Root () && index < m_end);
+  NS_ASSERT (m_heap[index].ev.key.m_uid == ev.key.m_uid);
+  NS_ASSERT (m_heap[index].ev.impl == ev.impl);
+  m_end--;
+  if (index == m_end)
+    {
+      return;
+    }
+  // fill the hole with the last event: it can be smaller than the
+  // parent of the hole as well as larger than its children.
+  Event last = m_heap[m_end].ev;
+  if (!IsRoot (index) && last.key < m_heap[Parent (index)].ev.key)
+    {
+      BottomUp (index, last);
+    }
+  else
+    {
+      TopDown (index, last);
+    }
+}
+
+void
+QuadHeapScheduler::RemoveNextBatch (uint64_t maxTs, std::vector<Event> &events)
+{
+  while (!IsEmpty () && m_heap[Root ()].ev.key.m_ts <= maxTs)
+    {
+      events.push_back (m_heap[Root ()].ev);
+      RemoveRoot ();
+    }
+}
+
+bool
+QuadHeapScheduler::IsIndexed (void) const
+{
+  return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef QUAD_HEAP_SCHEDULER_H
+#define QUAD_HEAP_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a cache-friendly 4-ary implicit heap event scheduler
+ *
+ * This scheduler is a d-ary heap with d=4 stored in a single
+ * contiguous array. Compared to the HeapScheduler, it is designed
+ * to minimize the number of cache lines touched per operation:
+ *  - each node stores the event key and the EventImpl pointer
+ *    contiguously and is padded to 32 bytes, so that the four
+ *    children of a node always share one 128-byte, cache-line-aligned
+ *    block. The root is stored at index 3 of the array to obtain
+ *    this alignment for every sibling group.
+ *  - the heap is half as deep as a binary heap so that RemoveNext
+ *    performs half as many levels of top-down heapify.
+ *  - sift operations move a "hole" rather than swapping entries.
+ *
+ * Remove does not search the heap: each event records its current
+ * slot with EventImpl::SetSchedulerHandle so that the removed event
+ * is located immediately and its slot is refilled with a single
+ * O(log n) sift. Removed events thus never linger in the heap.
+ */
+class QuadHeapScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  QuadHeapScheduler ();
+  virtual ~QuadHeapScheduler ();
+
+  virtual void Insert (const Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Event PeekNext (void) const;
+  virtual Event RemoveNext (void);
+  virtual void Remove (const Event &ev);
+  virtual void RemoveNextBatch (uint64_t maxTs, std::vector<Event> &events);
+  virtual bool IsIndexed (void) const;
+
+private:
+  union Node
+  {
+    Event ev;
+    uint8_t padding[32];
+  };
+
+  inline uint32_t Parent (uint32_t id) const;
+  inline uint32_t FirstChild (uint32_t id) const;
+  inline uint32_t Root (void) const;
+  inline bool IsRoot (uint32_t id) const;
+
+  void Grow (void);
+  inline void Store (uint32_t index, const Event &ev);
+  void BottomUp (uint32_t index, const Event &ev);
+  void TopDown (uint32_t index, const Event &ev);
+  void RemoveRoot (void);
+
+  uint8_t *m_buffer;
+  Node *m_heap;
+  // index of the first unused slot in m_heap
+  uint32_t m_end;
+  uint32_t m_capacity;
+};
+
+} // namespace ns3
+
+#endif /* QUAD_HEAP_SCHEDULER_H */
@@ -38,4 +38,19 @@ Scheduler::GetTypeId (void)
   return tid;
 }
 
+void
+Scheduler::RemoveNextBatch (uint64_t maxTs, std::vector<Event> &events)
+{
+  while (!IsEmpty () && PeekNext ().key.m_ts <= maxTs)
+    {
+      events.push_back (RemoveNext ());
+    }
+}
+
+bool
+Scheduler::IsIndexed (void) const
+{
+  return false;
+}
+
 } // namespace ns3
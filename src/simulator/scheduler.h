@@ -22,6 +22,7 @@
 #define SCHEDULER_H
 
 #include <stdint.h>
+#include <vector>
 #include "ns3/object.h"
 
 namespace ns3 {
@@ -95,6 +96,29 @@ public:
    * This methods cannot be invoked if the list is empty.
    */
   virtual void Remove (const Event &ev) = 0;
+  /**
+   * \param maxTs the largest timestamp of the events to remove
+   * \param events output list to which the removed events are appended
+   *        in increasing order.
+   *
+   * Remove from the event list all the events whose timestamp is
+   * smaller than or equal to maxTs. The default implementation
+   * repeatedly calls PeekNext and RemoveNext: subclasses are expected
+   * to override it when they can detach a set of events in a single
+   * operation.
+   */
+  virtual void RemoveNextBatch (uint64_t maxTs, std::vector<Event> &events);
+  /**
+   * \returns true if Remove costs at most O(log n) in the size of
+   *          the event list.
+   *
+   * An indexed scheduler locates the events without searching for
+   * them: the simulator can then remove the cancelled events from
+   * the event list as soon as they are cancelled instead of leaving
+   * them in the list until they expire. The default implementation
+   * returns false.
+   */
+  virtual bool IsIndexed (void) const;
 };
 
 /* Note the invariants which this function must provide:
@@ -11,4 +11,18 @@ SimulatorImpl::GetTypeId (void)
   return tid;
 }
 
+struct SimulatorImpl::Statistics
+SimulatorImpl::GetStatistics (void) const
+{
+  struct Statistics stats;
+  stats.now = Now ();
+  stats.wallClock = 0;
+  stats.scheduled = 0;
+  stats.processed = 0;
+  stats.cancelled = 0;
+  stats.queueSize = 0;
+  stats.peakQueueSize = 0;
+  return stats;
+}
+
 } // namespace ns3
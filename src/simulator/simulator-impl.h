@@ -35,6 +35,28 @@ class Scheduler;
 class SimulatorImpl : public Object
 {
 public:
+  /**
+   * \brief a snapshot of the event counters of a simulator
+   */
+  struct Statistics
+  {
+    // the simulation time of the snapshot
+    Time now;
+    // wall-clock time spent in Run since the simulation started, in seconds
+    double wallClock;
+    // number of events scheduled, not counting the "destroy" events
+    uint64_t scheduled;
+    // number of events invoked, not counting the cancelled ones
+    uint64_t processed;
+    // number of events cancelled or removed before they expired
+    uint64_t cancelled;
+    // number of events currently in the event list, including the
+    // cancelled events which were not removed from it yet
+    uint32_t queueSize;
+    // the largest queueSize seen so far
+    uint32_t peakQueueSize;
+  };
+
   static TypeId GetTypeId (void);
 
   /**
@@ -195,6 +217,14 @@ public:
    * \return the current simulation context
    */
   virtual uint32_t GetContext (void) const = 0;
+  /**
+   * \return the current value of the event counters.
+   *
+   * The default implementation returns only the current simulation
+   * time and leaves all the counters to zero: the subclasses which
+   * keep track of their events override it.
+   */
+  virtual struct Statistics GetStatistics (void) const;
 };
 
 } // namespace ns3
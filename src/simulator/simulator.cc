@@ -383,9 +383,14 @@ Simulator::GetImplementation (void)
 #include "ns3/test.h"
 #include "list-scheduler.h"
 #include "heap-scheduler.h"
+#include "quad-heap-scheduler.h"
 #include "map-scheduler.h"
 #include "calendar-scheduler.h"
 #include "ns2-calendar-scheduler.h"
+#include "ladder-scheduler.h"
+#include "default-simulator-impl.h"
+#include "ns3/random-variable.h"
+#include "ns3/boolean.h"
 
 namespace ns3 {
 
@@ -532,6 +537,317 @@ SimulatorEventsTestCase::DoRun (void)
   return false;
 }
 
+class SimulatorRandomEventsTestCase : public TestCase
+{
+public:
+  SimulatorRandomEventsTestCase (ObjectFactory schedulerFactory);
+  virtual bool DoRun (void);
+  void Event (uint32_t i);
+  uint64_t m_lastTs;
+  uint32_t m_count;
+  bool m_ordered;
+  std::vector<bool> m_removed;
+  ObjectFactory m_schedulerFactory;
+};
+
+SimulatorRandomEventsTestCase::SimulatorRandomEventsTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check that randomly scheduled and removed events are handled in order with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{}
+
+void
+SimulatorRandomEventsTestCase::Event (uint32_t i)
+{
+  uint64_t ts = Simulator::Now ().GetTimeStep ();
+  if (ts < m_lastTs || m_removed[i])
+    {
+      m_ordered = false;
+    }
+  m_lastTs = ts;
+  m_count++;
+}
+
+bool
+SimulatorRandomEventsTestCase::DoRun (void)
+{
+  const uint32_t n = 2000;
+  m_lastTs = 0;
+  m_count = 0;
+  m_ordered = true;
+  m_removed = std::vector<bool> (n, false);
+
+  Simulator::SetScheduler (m_schedulerFactory);
+
+  UniformVariable delay (0, 1000);
+  std::vector<EventId> ids;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      // many events share the same timestamp on purpose.
+      Time t = MicroSeconds ((uint64_t)delay.GetValue ());
+      ids.push_back (Simulator::Schedule (t, &SimulatorRandomEventsTestCase::Event, this, i));
+    }
+  uint32_t expected = n;
+  for (uint32_t i = 0; i < n; i += 3)
+    {
+      Simulator::Remove (ids[i]);
+      m_removed[i] = true;
+      expected--;
+    }
+  uint32_t cancelled = 0;
+  for (uint32_t i = 1; i < n; i += 3)
+    {
+      Simulator::Cancel (ids[i]);
+      m_removed[i] = true;
+      expected--;
+      cancelled++;
+    }
+  Ptr<DefaultSimulatorImpl> impl = DynamicCast<DefaultSimulatorImpl> (Simulator::GetImplementation ());
+  if (impl != 0)
+    {
+      // indexed schedulers drop the cancelled events immediately.
+      Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+      uint32_t dead = scheduler->IsIndexed () ? 0 : cancelled;
+      NS_TEST_EXPECT_MSG_EQ (impl->GetDeadEventCount (), dead, "Unexpected number of cancelled events in the event list");
+    }
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_ordered, true, "Events were not invoked in order or removed events were invoked");
+  NS_TEST_EXPECT_MSG_EQ (m_count, expected, "Unexpected number of invoked events");
+  if (impl != 0)
+    {
+      NS_TEST_EXPECT_MSG_EQ (impl->GetDeadEventCount (), 0, "Cancelled events were left in the event list");
+    }
+  Simulator::Destroy ();
+
+  return false;
+}
+
+class SimulatorShortHorizonTestCase : public TestCase
+{
+public:
+  SimulatorShortHorizonTestCase (ObjectFactory schedulerFactory);
+  virtual bool DoRun (void);
+  void Burst (uint32_t remaining);
+  void Event (void);
+  uint64_t m_lastTs;
+  uint32_t m_count;
+  bool m_ordered;
+  UniformVariable m_delay;
+  ObjectFactory m_schedulerFactory;
+};
+
+SimulatorShortHorizonTestCase::SimulatorShortHorizonTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check that bursts of short-horizon events next to a far event are handled in order with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_delay (0, 50000),
+    m_schedulerFactory (schedulerFactory)
+{}
+
+void
+SimulatorShortHorizonTestCase::Event (void)
+{
+  uint64_t ts = Simulator::Now ().GetTimeStep ();
+  if (ts < m_lastTs)
+    {
+      m_ordered = false;
+    }
+  m_lastTs = ts;
+  m_count++;
+}
+
+void
+SimulatorShortHorizonTestCase::Burst (uint32_t remaining)
+{
+  Event ();
+  // like the backoff slots of many stations: a few hundred events
+  // within the next 50us, far below the end of the simulation.
+  for (uint32_t i = 0; i < 200; i++)
+    {
+      Simulator::Schedule (NanoSeconds ((uint64_t)m_delay.GetValue ()),
+                           &SimulatorShortHorizonTestCase::Event, this);
+    }
+  if (remaining > 0)
+    {
+      Simulator::Schedule (MicroSeconds (20), &SimulatorShortHorizonTestCase::Burst, this, remaining - 1);
+    }
+}
+
+bool
+SimulatorShortHorizonTestCase::DoRun (void)
+{
+  const uint32_t nBursts = 100;
+  m_lastTs = 0;
+  m_count = 0;
+  m_ordered = true;
+
+  Simulator::SetScheduler (m_schedulerFactory);
+  Simulator::Schedule (Seconds (100), &SimulatorShortHorizonTestCase::Event, this);
+  Simulator::Schedule (Seconds (0), &SimulatorShortHorizonTestCase::Burst, this, nBursts - 1);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_ordered, true, "Events were not invoked in order");
+  NS_TEST_EXPECT_MSG_EQ (m_count, nBursts * 201 + 1, "Unexpected number of invoked events");
+  Simulator::Destroy ();
+
+  return false;
+}
+
+class SimulatorSameTimeTestCase : public TestCase
+{
+public:
+  SimulatorSameTimeTestCase (ObjectFactory schedulerFactory, bool batch);
+  virtual bool DoRun (void);
+  void First (void);
+  void Record (uint32_t i);
+  void Stop (void);
+  std::vector<uint32_t> m_order;
+  std::vector<EventId> m_ids;
+  ObjectFactory m_schedulerFactory;
+  bool m_batch;
+};
+
+SimulatorSameTimeTestCase::SimulatorSameTimeTestCase (ObjectFactory schedulerFactory, bool batch)
+  : TestCase ("Check that events scheduled at the same time are dispatched in order with " +
+              schedulerFactory.GetTypeId ().GetName () + (batch ? " and batch dispatch" : "")),
+    m_schedulerFactory (schedulerFactory),
+    m_batch (batch)
+{}
+
+void
+SimulatorSameTimeTestCase::First (void)
+{
+  m_order.push_back (0);
+  // remove and cancel events which share our timestamp.
+  Simulator::Remove (m_ids[2]);
+  Simulator::Cancel (m_ids[3]);
+  Simulator::ScheduleNow (&SimulatorSameTimeTestCase::Record, this, 5);
+}
+
+void
+SimulatorSameTimeTestCase::Record (uint32_t i)
+{
+  m_order.push_back (i);
+}
+
+void
+SimulatorSameTimeTestCase::Stop (void)
+{
+  m_order.push_back (6);
+  Simulator::Stop ();
+}
+
+bool
+SimulatorSameTimeTestCase::DoRun (void)
+{
+  Simulator::SetScheduler (m_schedulerFactory);
+  Ptr<DefaultSimulatorImpl> impl = DynamicCast<DefaultSimulatorImpl> (Simulator::GetImplementation ());
+  if (impl != 0)
+    {
+      impl->SetAttribute ("BatchDispatch", BooleanValue (m_batch));
+    }
+
+  m_ids.push_back (Simulator::Schedule (Seconds (1), &SimulatorSameTimeTestCase::First, this));
+  for (uint32_t i = 1; i < 5; i++)
+    {
+      m_ids.push_back (Simulator::Schedule (Seconds (1), &SimulatorSameTimeTestCase::Record, this, i));
+    }
+  Simulator::Schedule (Seconds (2), &SimulatorSameTimeTestCase::Stop, this);
+  Simulator::Schedule (Seconds (2), &SimulatorSameTimeTestCase::Record, this, 7);
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_ids[2].IsExpired (), true, "Removed event should have expired");
+  uint32_t expected[] = {0, 1, 4, 5, 6};
+  NS_TEST_EXPECT_MSG_EQ (m_order.size (), 5, "Unexpected number of events invoked before Stop");
+  for (uint32_t i = 0; i < m_order.size () && i < 5; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_order[i], expected[i], "Events invoked out of order");
+    }
+
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_order.size (), 6, "The event after Stop did not run");
+  NS_TEST_EXPECT_MSG_EQ (m_order.back (), 7, "The event after Stop did not run");
+  Simulator::Destroy ();
+
+  return false;
+}
+
+class SimulatorStatisticsTestCase : public TestCase
+{
+public:
+  SimulatorStatisticsTestCase (ObjectFactory schedulerFactory);
+  virtual bool DoRun (void);
+  void Event (void);
+  void Sample (const SimulatorImpl::Statistics &stats);
+  std::vector<SimulatorImpl::Statistics> m_samples;
+  ObjectFactory m_schedulerFactory;
+};
+
+SimulatorStatisticsTestCase::SimulatorStatisticsTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check the event counters and their periodic samples with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{}
+
+void
+SimulatorStatisticsTestCase::Event (void)
+{}
+
+void
+SimulatorStatisticsTestCase::Sample (const SimulatorImpl::Statistics &stats)
+{
+  m_samples.push_back (stats);
+}
+
+bool
+SimulatorStatisticsTestCase::DoRun (void)
+{
+  Simulator::SetScheduler (m_schedulerFactory);
+  Ptr<DefaultSimulatorImpl> impl = DynamicCast<DefaultSimulatorImpl> (Simulator::GetImplementation ());
+  if (impl == 0)
+    {
+      Simulator::Destroy ();
+      return false;
+    }
+  impl->SetAttribute ("StatisticsInterval", TimeValue (MicroSeconds (2)));
+  impl->TraceConnectWithoutContext ("Statistics", MakeCallback (&SimulatorStatisticsTestCase::Sample, this));
+
+  std::vector<EventId> ids;
+  for (uint32_t i = 1; i <= 10; i++)
+    {
+      ids.push_back (Simulator::Schedule (MicroSeconds (i), &SimulatorStatisticsTestCase::Event, this));
+    }
+  Simulator::Cancel (ids[2]);
+  Simulator::Remove (ids[3]);
+  SimulatorImpl::Statistics stats = impl->GetStatistics ();
+  NS_TEST_EXPECT_MSG_EQ (stats.scheduled, 10, "Unexpected number of scheduled events");
+  NS_TEST_EXPECT_MSG_EQ (stats.cancelled, 2, "Unexpected number of cancelled events");
+  NS_TEST_EXPECT_MSG_EQ (stats.peakQueueSize, 10, "Unexpected peak queue size");
+
+  Simulator::Run ();
+  stats = impl->GetStatistics ();
+  NS_TEST_EXPECT_MSG_EQ (stats.processed, 8, "Unexpected number of processed events");
+  NS_TEST_EXPECT_MSG_EQ (stats.cancelled, 2, "Unexpected number of cancelled events");
+  NS_TEST_EXPECT_MSG_EQ (stats.queueSize, 0, "Events were left in the event list");
+  NS_TEST_EXPECT_MSG_EQ (stats.peakQueueSize, 10, "Unexpected peak queue size");
+
+  // a sample is taken by the first event at or after each multiple of
+  // 2us: the event at 4us was removed so the event at 5us takes it.
+  uint32_t expected[] = {2, 5, 6, 8, 10};
+  NS_TEST_EXPECT_MSG_EQ (m_samples.size (), 5, "Unexpected number of samples");
+  for (uint32_t i = 0; i < m_samples.size () && i < 5; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_samples[i].now, MicroSeconds (expected[i]), "Unexpected sample time");
+    }
+  if (m_samples.size () == 5)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_samples[0].processed, 1, "Unexpected number of processed events");
+      NS_TEST_EXPECT_MSG_EQ (m_samples[4].processed, 7, "Unexpected number of processed events");
+      NS_TEST_EXPECT_MSG_EQ (m_samples[4].queueSize, 0, "Unexpected queue size");
+    }
+  Simulator::Destroy ();
+
+  return false;
+}
+
 class SimulatorTemplateTestCase : public TestCase
 {
 public:
@@ -842,6 +1158,41 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory));
     factory.SetTypeId (Ns2CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory));
+    factory.SetTypeId (QuadHeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory));
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory));
+
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorRandomEventsTestCase (factory));
+    factory.SetTypeId (HeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorRandomEventsTestCase (factory));
+    factory.SetTypeId (QuadHeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorRandomEventsTestCase (factory));
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorRandomEventsTestCase (factory));
+
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorShortHorizonTestCase (factory));
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorShortHorizonTestCase (factory));
+
+    for (uint32_t batch = 0; batch < 2; batch++)
+      {
+        factory.SetTypeId (MapScheduler::GetTypeId ());
+        AddTestCase (new SimulatorSameTimeTestCase (factory, batch));
+        factory.SetTypeId (HeapScheduler::GetTypeId ());
+        AddTestCase (new SimulatorSameTimeTestCase (factory, batch));
+        factory.SetTypeId (QuadHeapScheduler::GetTypeId ());
+        AddTestCase (new SimulatorSameTimeTestCase (factory, batch));
+        factory.SetTypeId (LadderScheduler::GetTypeId ());
+        AddTestCase (new SimulatorSameTimeTestCase (factory, batch));
+      }
+
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorStatisticsTestCase (factory));
+    factory.SetTypeId (HeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorStatisticsTestCase (factory));
   }
 } g_simulatorTestSuite;
 
@@ -296,7 +296,39 @@ ArithTestCase::DoRun (void)
   return false;
 }
 
+class TimeConversionTestCase : public TestCase
+{
+public:
+  TimeConversionTestCase ();
+private:
+  virtual bool DoRun (void);
+};
+
+TimeConversionTestCase::TimeConversionTestCase ()
+  : TestCase ("Check the conversions of the common units")
+{
+}
+bool
+TimeConversionTestCase::DoRun (void)
+{
+  enum Time::Unit originalResolution = Time::GetResolution ();
+  Time::SetResolution (Time::NS);
+  NS_TEST_ASSERT_MSG_EQ (Seconds (1.5).GetMicroSeconds (), 1500000, "Seconds to microseconds");
+  NS_TEST_ASSERT_MSG_EQ (Seconds (0.25).GetNanoSeconds (), 250000000, "Seconds to nanoseconds");
+  NS_TEST_ASSERT_MSG_EQ (MilliSeconds (3).GetMicroSeconds (), 3000, "Milliseconds to microseconds");
+  NS_TEST_ASSERT_MSG_EQ (MicroSeconds (3).GetNanoSeconds (), 3000, "Microseconds to nanoseconds");
+  NS_TEST_ASSERT_MSG_EQ (NanoSeconds (2500).GetMicroSeconds (), 2, "Nanoseconds to microseconds");
+  NS_TEST_ASSERT_MSG_EQ_TOL (NanoSeconds (1500).GetSeconds (), 1.5e-6, 1e-15, "Nanoseconds to seconds");
 
+  // the products by fractional scalars must not be truncated
+  NS_TEST_ASSERT_MSG_EQ ((MicroSeconds (10) * Scalar (0.5)).GetNanoSeconds (), 5000, "Time * Scalar");
+  NS_TEST_ASSERT_MSG_EQ ((Scalar (0.25) * MicroSeconds (4)).GetNanoSeconds (), 1000, "Scalar * Time");
+  NS_TEST_ASSERT_MSG_EQ ((MicroSeconds (10) / Scalar (4)).GetNanoSeconds (), 2500, "Time / Scalar");
+  NS_TEST_ASSERT_MSG_EQ (((MicroSeconds (10) + NanoSeconds (5)) - MicroSeconds (3)).GetNanoSeconds (), 7005,
+                         "Time + Time - Time");
+  Time::SetResolution (originalResolution);
+  return false;
+}
 
 static class TimeTestSuite : public TestSuite
 {
@@ -307,6 +339,7 @@ public:
     AddTestCase (new Bug863TestCase ());
     AddTestCase (new TimeSimpleTestCase (Time::US));
     AddTestCase (new ArithTestCase ());
+    AddTestCase (new TimeConversionTestCase ());
   }
 } g_timeTestSuite;
 
@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Time the event loop on the mesh scenario of scratch/ngwmn.cc: a 7x7
+ * grid of 802.11s mesh points, 100 m apart, on spread channels, with
+ * three UDP flows of 1024-byte packets every 10 ms towards the gateway
+ * in the corner of the grid. Each broadcast frame (beacons, peer link
+ * frames, HWMP path requests) schedules one receive event per mesh
+ * point in range at the same timestamp.
+ *
+ * --batch=1 makes DefaultSimulatorImpl detach the events from the
+ * scheduler by timestamp instead of one by one, so that both dispatch
+ * loops can be compared on the same scheduler and the same events.
+ * Other programs can be timed the same way with
+ * --ns3::DefaultSimulatorImpl::BatchDispatch=true.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/simulator-module.h"
+#include "ns3/node-module.h"
+#include "ns3/helper-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mesh-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/mesh-helper.h"
+#include "ns3/system-wall-clock-ms.h"
+#include <iostream>
+
+using namespace ns3;
+
+static void
+InstallClient (Ipv4Address gateway, Ptr<Node> node, double start, double stop)
+{
+  UdpClientHelper client (gateway, 4000);
+  client.SetAttribute ("MaxPackets", UintegerValue (100000));
+  client.SetAttribute ("PacketSize", UintegerValue (1024));
+  client.SetAttribute ("Interval", TimeValue (Seconds (0.01)));
+  ApplicationContainer apps = client.Install (node);
+  apps.Start (Seconds (start));
+  apps.Stop (Seconds (stop));
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t size = 7;
+  double totalTime = 100.0;
+  std::string scheduler = "ns3::MapScheduler";
+  bool batch = false;
+
+  CommandLine cmd;
+  cmd.AddValue ("size", "The number of mesh points in a row and in a column of the grid", size);
+  cmd.AddValue ("time", "The simulation time, in seconds", totalTime);
+  cmd.AddValue ("scheduler", "The TypeId of the scheduler", scheduler);
+  cmd.AddValue ("batch", "Detach the events which share a timestamp at once", batch);
+  cmd.Parse (argc, argv);
+
+  Config::SetDefault ("ns3::DefaultSimulatorImpl::BatchDispatch", BooleanValue (batch));
+  ObjectFactory factory;
+  factory.SetTypeId (scheduler);
+  Simulator::SetScheduler (factory);
+
+  NodeContainer nodes;
+  nodes.Create (size * size);
+  YansWifiPhyHelper wifiPhy = YansWifiPhyHelper::Default ();
+  YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default ();
+  wifiPhy.SetChannel (wifiChannel.Create ());
+  MeshHelper mesh = MeshHelper::Default ();
+  mesh.SetStackInstaller ("ns3::Dot11sStack");
+  mesh.SetSpreadInterfaceChannels (MeshHelper::SPREAD_CHANNELS);
+  mesh.SetMacType ("RandomStart", TimeValue (Seconds (0.5)));
+  mesh.SetNumberOfInterfaces (1);
+  NetDeviceContainer meshDevices = mesh.Install (wifiPhy, nodes);
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "MinX", DoubleValue (0.0),
+                                 "MinY", DoubleValue (0.0),
+                                 "DeltaX", DoubleValue (100.0),
+                                 "DeltaY", DoubleValue (100.0),
+                                 "GridWidth", UintegerValue (size),
+                                 "LayoutType", StringValue ("RowFirst"));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  InternetStackHelper internetStack;
+  internetStack.Install (nodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (meshDevices);
+
+  UdpServerHelper server (4000);
+  ApplicationContainer serverApps = server.Install (nodes.Get (0));
+  serverApps.Start (Seconds (1.0));
+  serverApps.Stop (Seconds (totalTime));
+  InstallClient (interfaces.GetAddress (0), nodes.Get (size * size - 1), 2.0, totalTime);
+  InstallClient (interfaces.GetAddress (0), nodes.Get (1), 10.0, totalTime);
+  InstallClient (interfaces.GetAddress (0), nodes.Get (size * size - size), 15.0, totalTime);
+
+  Simulator::Stop (Seconds (totalTime));
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  double simu = clock.End () / 1000.0;
+  SimulatorImpl::Statistics stats = Simulator::GetImplementation ()->GetStatistics ();
+  Simulator::Destroy ();
+
+  std::cout << scheduler << (batch ? " batch" : " one by one") << ": "
+            << stats.processed << " events in " << simu << "s, "
+            << stats.processed / simu << " events/s" << std::endl;
+  return 0;
+}
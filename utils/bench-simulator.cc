@@ -36,6 +36,7 @@ public:
   Bench ();
   void ReadDistribution (std::istream &istream);
   void SetTotal (uint32_t total);
+  void SetBurst (uint32_t burst);
   void RunBench (void);
 private:
   void Cb (void);
@@ -43,13 +44,21 @@ private:
   std::vector<uint64_t>::const_iterator m_current;
   uint32_t m_n;
   uint32_t m_total;
+  uint32_t m_burst;
 };
 
 Bench::Bench ()
   : m_n (0),
-    m_total (0)
+    m_total (0),
+    m_burst (1)
 {}
 
+void 
+Bench::SetBurst (uint32_t burst)
+{
+  m_burst = (burst > 0) ? burst : 1;
+}
+
 void 
 Bench::SetTotal (uint32_t total)
 {
@@ -81,11 +90,15 @@ Bench::RunBench (void)
 {
   SystemWallClockMs time;
   double init, simu;
+  m_n = 0;
   time.Start ();
   for (std::vector<uint64_t>::const_iterator i = m_distribution.begin ();
        i != m_distribution.end (); i++) 
     {
-      Simulator::Schedule (NanoSeconds (*i), &Bench::Cb, this);
+      for (uint32_t j = 0; j < m_burst; j++)
+        {
+          Simulator::Schedule (NanoSeconds (*i), &Bench::Cb, this);
+        }
     }
   init = time.End ();
   init /= 1000;
@@ -98,10 +111,10 @@ Bench::RunBench (void)
   simu /= 1000;
 
   std::cout <<
-      "init n=" << m_distribution.size () << ", time=" << init << "s" << std::endl <<
+      "init n=" << m_distribution.size () * m_burst << ", time=" << init << "s" << std::endl <<
       "simu n=" << m_n << ", time=" <<simu << "s" << std::endl <<
-      "init " << ((double)m_distribution.size ()) / init << " insert/s, avg insert=" <<
-      init / ((double)m_distribution.size ())<< "s" << std::endl <<
+      "init " << ((double)m_distribution.size () * m_burst) / init << " insert/s, avg insert=" <<
+      init / ((double)m_distribution.size () * m_burst)<< "s" << std::endl <<
       "simu " << ((double)m_n) / simu<< " hold/s, avg hold=" << 
       simu / ((double)m_n) << "s" << std::endl
       ;
@@ -122,9 +135,17 @@ Bench::Cb (void)
     {
       std::cerr << "event at " << Simulator::Now ().GetSeconds () << "s" << std::endl;
     }
-  Simulator::Schedule (NanoSeconds (*m_current), &Bench::Cb, this);
-  m_current++;
   m_n++;
+  if (m_n % m_burst != 0)
+    {
+      return;
+    }
+  // model a broadcast: schedule m_burst events at the same time.
+  for (uint32_t j = 0; j < m_burst; j++)
+    {
+      Simulator::Schedule (NanoSeconds (*m_current), &Bench::Cb, this);
+    }
+  m_current++;
 }
 
 void
@@ -136,6 +157,12 @@ PrintHelp (void)
   std::cout << "      --list: use std::list scheduler"<<std::endl;
   std::cout << "      --map: use std::map cheduler"<<std::endl;
   std::cout << "      --heap: use Binary Heap scheduler"<<std::endl;
+  std::cout << "      --quadheap: use 4-ary Heap scheduler"<<std::endl;
+  std::cout << "      --calendar: use Calendar Queue scheduler"<<std::endl;
+  std::cout << "      --ns2calendar: use ns-2 Calendar Queue scheduler"<<std::endl;
+  std::cout << "      --ladder: use Ladder Queue scheduler"<<std::endl;
+  std::cout << "      --all: compare all of the above schedulers"<<std::endl;
+  std::cout << "      --burst=N: schedule events by groups of N events with the same timestamp"<<std::endl;
   std::cout << "      --debug: enable some debugging"<<std::endl;
 }
 
@@ -145,6 +172,7 @@ int main (int argc, char *argv[])
   std::istream *input;
   uint32_t n = 1;
   uint32_t total = 20000;
+  uint32_t burst = 1;
   if (argc == 1)
     {
       PrintHelp ();
@@ -160,28 +188,46 @@ int main (int argc, char *argv[])
     {
       input = new std::ifstream (filename);
     }
+  std::vector<std::string> schedulers;
   while (argc > 0) 
     {
-      ObjectFactory factory;
       if (strcmp ("--list", argv[0]) == 0) 
         {
-          factory.SetTypeId ("ns3::ListScheduler");
-          Simulator::SetScheduler (factory);
+          schedulers.push_back ("ns3::ListScheduler");
         } 
       else if (strcmp ("--heap", argv[0]) == 0) 
         {
-          factory.SetTypeId ("ns3::HeapScheduler");
-          Simulator::SetScheduler (factory);
+          schedulers.push_back ("ns3::HeapScheduler");
+        } 
+      else if (strcmp ("--quadheap", argv[0]) == 0) 
+        {
+          schedulers.push_back ("ns3::QuadHeapScheduler");
         } 
       else if (strcmp ("--map", argv[0]) == 0) 
         {
-          factory.SetTypeId ("ns3::HeapScheduler");
-          Simulator::SetScheduler (factory);
+          schedulers.push_back ("ns3::MapScheduler");
         } 
       else if (strcmp ("--calendar", argv[0]) == 0)
         {
-          factory.SetTypeId ("ns3::CalendarScheduler");
-          Simulator::SetScheduler (factory);
+          schedulers.push_back ("ns3::CalendarScheduler");
+        }
+      else if (strcmp ("--ns2calendar", argv[0]) == 0)
+        {
+          schedulers.push_back ("ns3::Ns2CalendarScheduler");
+        }
+      else if (strcmp ("--ladder", argv[0]) == 0)
+        {
+          schedulers.push_back ("ns3::LadderScheduler");
+        }
+      else if (strcmp ("--all", argv[0]) == 0)
+        {
+          schedulers.push_back ("ns3::ListScheduler");
+          schedulers.push_back ("ns3::MapScheduler");
+          schedulers.push_back ("ns3::HeapScheduler");
+          schedulers.push_back ("ns3::QuadHeapScheduler");
+          schedulers.push_back ("ns3::CalendarScheduler");
+          schedulers.push_back ("ns3::Ns2CalendarScheduler");
+          schedulers.push_back ("ns3::LadderScheduler");
         }
       else if (strcmp ("--debug", argv[0]) == 0) 
         {
@@ -195,16 +241,33 @@ int main (int argc, char *argv[])
         {
           n = atoi (argv[0]+strlen ("--n="));
         } 
+      else if (strncmp ("--burst=", argv[0], strlen("--burst=")) == 0) 
+        {
+          burst = atoi (argv[0]+strlen ("--burst="));
+        } 
 
       argc--;
       argv++;
   }
+  if (schedulers.empty ())
+    {
+      schedulers.push_back ("ns3::MapScheduler");
+    }
   Bench *bench = new Bench ();
   bench->ReadDistribution (*input);
   bench->SetTotal (total);
-  for (uint32_t i = 0; i < n; i++)
+  bench->SetBurst (burst);
+  for (std::vector<std::string>::const_iterator s = schedulers.begin (); s != schedulers.end (); s++)
     {
-      bench->RunBench ();
+      std::cout << "scheduler=" << *s << std::endl;
+      ObjectFactory factory;
+      factory.SetTypeId (*s);
+      Simulator::SetScheduler (factory);
+      for (uint32_t i = 0; i < n; i++)
+        {
+          bench->RunBench ();
+        }
+      Simulator::Destroy ();
     }
 
   return 0;
@@ -0,0 +1,216 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the cost of the Time operations which are used the most by
+ * the MAC timers: additions, comparisons and conversions from and to
+ * the common units. The HighPrecision implementation which backs Time
+ * is chosen at configure time so this program cannot compare the
+ * implementations within one build: it measures the one it was built
+ * with. To compare them, configure two build directories and run the
+ * program from each one:
+ *
+ *   ./waf configure -d optimized -b build-hp
+ *   ./waf build && ./build-hp/optimized/utils/bench-time
+ *   ./waf configure -d optimized -b build-int64 --high-precision-as-int64
+ *   ./waf build && ./build-int64/optimized/utils/bench-time
+ *
+ * (the 128 bit implementation is used when the compiler supports
+ * 128 bit integers, the cairo one otherwise). Each benchmark is also
+ * run on plain int64_t values which give the lower bound.
+ */
+
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/simulator-config.h"
+#include "ns3/nstime.h"
+#include <iostream>
+#include <sstream>
+#include <string.h>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+// the results are accumulated here to keep the compiler from
+// optimizing the loops away.
+static volatile int64_t g_sink;
+
+static void
+benchAdd (uint32_t n)
+{
+  Time t = Seconds (0);
+  Time limit = Seconds (1e6);
+  int64_t count = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      t += TimeStep (i & 0xff);
+      if (t < limit)
+        {
+          count++;
+        }
+    }
+  g_sink = t.GetTimeStep () + count;
+}
+
+static void
+benchAddRaw (uint32_t n)
+{
+  int64_t t = 0;
+  int64_t limit = 1000000000000000LL;
+  int64_t count = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      t += i & 0xff;
+      if (t < limit)
+        {
+          count++;
+        }
+    }
+  g_sink = t + count;
+}
+
+static void
+benchFromUnits (uint32_t n)
+{
+  Time t = Seconds (0);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      t += MicroSeconds (i & 0xff) + NanoSeconds (i & 0xf);
+    }
+  g_sink = t.GetTimeStep ();
+}
+
+static void
+benchFromUnitsRaw (uint32_t n)
+{
+  int64_t t = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      t += (int64_t)(i & 0xff) * 1000 + (i & 0xf);
+    }
+  g_sink = t;
+}
+
+static void
+benchSeconds (uint32_t n)
+{
+  Time t = Seconds (0);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      t += Seconds ((i & 0xff) * 1e-6);
+    }
+  g_sink = t.GetTimeStep ();
+}
+
+static void
+benchSecondsRaw (uint32_t n)
+{
+  int64_t t = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      double v = (i & 0xff) * 1e-6 * 1e9;
+      t += (int64_t)(v + 0.5);
+    }
+  g_sink = t;
+}
+
+static void
+benchToUnits (uint32_t n)
+{
+  double seconds = 0;
+  int64_t us = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Time t = TimeStep (i);
+      seconds += t.GetSeconds ();
+      us += t.GetMicroSeconds ();
+    }
+  g_sink = (int64_t)seconds + us;
+}
+
+static void
+benchToUnitsRaw (uint32_t n)
+{
+  double seconds = 0;
+  int64_t us = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      int64_t t = i;
+      seconds += t / 1e9;
+      us += t / 1000;
+    }
+  g_sink = (int64_t)seconds + us;
+}
+
+static void
+runBench (void (*bench) (uint32_t), void (*raw) (uint32_t), uint32_t n, char const *name)
+{
+  SystemWallClockMs time;
+  time.Start ();
+  (*bench) (n);
+  uint64_t timeMs = time.End ();
+  time.Start ();
+  (*raw) (n);
+  uint64_t rawMs = time.End ();
+  std::cout << name << ": time=" << timeMs << "ms int64_t=" << rawMs << "ms" << std::endl;
+}
+
+static char const *
+GetImplementationName (void)
+{
+#if defined (USE_HIGH_PRECISION_DOUBLE)
+  return "long double";
+#elif defined (USE_HIGH_PRECISION_128)
+  return "128-bit integer";
+#elif defined (USE_HIGH_PRECISION_CAIRO)
+  return "cairo 128-bit integer";
+#elif defined (USE_HIGH_PRECISION_INT64)
+  return "64-bit integer";
+#else
+  return "unknown";
+#endif
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  while (argc > 0)
+    {
+      if (strncmp ("--n=", argv[0], strlen ("--n=")) == 0)
+        {
+          char const *nAscii = argv[0] + strlen ("--n=");
+          std::istringstream iss;
+          iss.str (nAscii);
+          iss >> n;
+        }
+      argc--;
+      argv++;
+    }
+  if (n == 0)
+    {
+      std::cerr << "Error-- number of iterations must be specified " <<
+        "by command-line argument --n=(number of iterations)" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-time with n=" << n
+            << " and a " << GetImplementationName () << " time implementation" << std::endl;
+
+  runBench (&benchAdd, &benchAddRaw, n, "add+compare");
+  runBench (&benchFromUnits, &benchFromUnitsRaw, n, "MicroSeconds+NanoSeconds");
+  runBench (&benchSeconds, &benchSecondsRaw, n, "Seconds");
+  runBench (&benchToUnits, &benchToUnitsRaw, n, "GetSeconds+GetMicroSeconds");
+
+  return 0;
+}